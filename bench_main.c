@@ -0,0 +1,34 @@
+#include <stdio.h>             // Biblioteca padrão para entrada/saída
+#include "inc/display_bench.h" // Benchmark das primitivas do display
+
+#if !defined(SSD1306_USE_HOST)
+#include "pico/stdlib.h"
+#endif
+
+/*
+ * Programa do benchmark do display (alvo display_bench).
+ *
+ * Na placa a tabela sai pela USB serial e é repetida a cada 10 segundos, para
+ * dar tempo de abrir o terminal. No host (tools/CMakeLists.txt) roda uma vez
+ * sobre o display emulado; a saída pode ser redirecionada para um arquivo .csv.
+ */
+int main()
+{
+#if defined(SSD1306_USE_HOST)
+    ssd1306_Init();
+    ssd1306_Benchmark();
+    return 0;
+#else
+    // Inicializa todas as interfaces padrão de entrada/saída (UART, USB, etc.)
+    stdio_init_all();
+
+    // Inicializa o display SSD1306 (OLED)
+    ssd1306_Init();
+
+    while(1)
+    {
+        ssd1306_Benchmark();
+        sleep_ms(10000);
+    }
+#endif
+}
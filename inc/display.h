@@ -5,12 +5,28 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <_ansi.h>
+#include <stdbool.h>
 
-_BEGIN_STD_C
+#include "inc/display_config.h"
 
+#if defined(SSD1306_USE_HOST)
+// Build do host (testes e benchmarks sem a placa): sem newlib nem Pico SDK
+#ifdef __cplusplus
+#define _BEGIN_STD_C extern "C" {
+#define _END_STD_C }
+#else
+#define _BEGIN_STD_C
+#define _END_STD_C
+#endif
+#define _u(x) x ## u
+#else
+#include <_ansi.h>
 #include "pico/stdlib.h"
-#include "inc/display_config.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#endif
+
+_BEGIN_STD_C
 
 #define SSD1306_I2C_CLK 400
 
@@ -36,6 +52,8 @@ _BEGIN_STD_C
 
 #if defined(SSD1306_USE_I2C)
 #define SSD1306_I2C_PORT        i2c1
+#elif defined(SSD1306_USE_HOST)
+#include "inc/display_host.h"
 #else
 #error "You should define SSD1306_USE_SPI or SSD1306_USE_I2C macro!"
 #endif
@@ -56,6 +74,31 @@ _BEGIN_STD_C
 
 #define SSD1306_SET_DISP _u(0xAE)
 
+// Número de páginas (linhas de 8 pixels) do display
+#define SSD1306_PAGES           (SSD1306_HEIGHT / 8)
+
+// Maior painel atendido pelos contextos (ssd1306_InitDisplay): define o tamanho
+// dos buffers de cada um. SSD1306_WIDTH/HEIGHT são a geometria do display padrão.
+#ifndef SSD1306_MAX_WIDTH
+#define SSD1306_MAX_WIDTH       128
+#endif
+#ifndef SSD1306_MAX_HEIGHT
+#define SSD1306_MAX_HEIGHT      ((SSD1306_HEIGHT > 64) ? SSD1306_HEIGHT : 64)
+#endif
+#define SSD1306_MAX_PAGES       (SSD1306_MAX_HEIGHT / 8)
+#define SSD1306_MAX_BUFFER_SIZE (SSD1306_MAX_WIDTH * SSD1306_MAX_HEIGHT / 8)
+
+// Quantidade de displays (contextos) inicializados ao mesmo tempo
+#ifndef SSD1306_MAX_DISPLAYS
+#define SSD1306_MAX_DISPLAYS    4
+#endif
+
+// Desperdício máximo (em bytes) aceito ao unir páginas sujas vizinhas numa
+// mesma janela de endereçamento, em vez de abrir uma janela nova (0x21/0x22).
+#ifndef SSD1306_DIRTY_MERGE_SLACK
+#define SSD1306_DIRTY_MERGE_SLACK 12
+#endif
+
 #define JOYSTICK_BUTTON 22
 
 typedef enum {
@@ -69,40 +112,326 @@ typedef enum {
 } SSD1306_Error_t;
 
 
+/* Intervalo entre dois passos do scroll por hardware, em frames (código do comando 0x26/0x27) */
+typedef enum {
+    SSD1306_SCROLL_2_FRAMES   = 0x07,
+    SSD1306_SCROLL_3_FRAMES   = 0x04,
+    SSD1306_SCROLL_4_FRAMES   = 0x05,
+    SSD1306_SCROLL_5_FRAMES   = 0x00,
+    SSD1306_SCROLL_25_FRAMES  = 0x06,
+    SSD1306_SCROLL_64_FRAMES  = 0x01,
+    SSD1306_SCROLL_128_FRAMES = 0x02,
+    SSD1306_SCROLL_256_FRAMES = 0x03
+} SSD1306_ScrollSpeed_t;
+
+/* Estado do gerenciador de inatividade */
+typedef enum {
+    SSD1306_IDLE_ACTIVE,     // Contraste normal
+    SSD1306_IDLE_DIMMING,    // Contraste descendo até SSD1306_IDLE_DIM_CONTRAST
+    SSD1306_IDLE_ASLEEP      // Display desligado e flushes suspensos
+} SSD1306_IdleState_t;
+
+/* Sentido do scroll horizontal */
+typedef enum {
+    SSD1306_SCROLL_RIGHT = 0,
+    SSD1306_SCROLL_LEFT  = 1
+} SSD1306_ScrollDir_t;
+
+/* Orientação da imagem no painel (sentido horário) */
+typedef enum {
+    SSD1306_ROTATE_0   = 0,
+    SSD1306_ROTATE_90  = 1,     // Retrato: largura e altura trocadas
+    SSD1306_ROTATE_180 = 2,
+    SSD1306_ROTATE_270 = 3      // Retrato: largura e altura trocadas
+} SSD1306_Rotation_t;
+
+/* Estatísticas de transmissão do ssd1306_UpdateScreen (bytes no barramento I2C) */
+typedef struct {
+    uint32_t frames;         // Quantidade de chamadas a ssd1306_UpdateScreen
+    uint32_t frame_seq;      // Frames que mudaram o que o painel mostra (número de sequência do conteúdo)
+    uint32_t last_sent;      // Bytes enviados no último frame
+    uint32_t last_saved;     // Bytes economizados no último frame em relação a um frame completo
+    uint32_t total_sent;     // Bytes enviados desde o início
+    uint32_t total_saved;    // Bytes economizados desde o início
+    uint32_t last_transactions;  // Transações I2C (START..STOP) do último frame
+    uint32_t total_transactions; // Transações I2C desde o início (inclui comandos avulsos)
+} SSD1306_FlushStats_t;
+
+/* Contadores do cache de textos de ssd1306_WriteString */
+typedef struct {
+    uint32_t hits;           // Textos desenhados com um único blit do cache
+    uint32_t misses;         // Textos rasterizados glifo a glifo (e guardados, se couberem)
+    uint32_t evictions;      // Textos descartados para abrir espaço (LRU)
+    uint16_t bytes_used;     // Bytes do cache ocupados agora
+} SSD1306_TextCacheStats_t;
+
+// Quantidade máxima de vértices de ssd1306_FillPolygon
+#ifndef SSD1306_POLY_MAX_VERTICES
+#define SSD1306_POLY_MAX_VERTICES 16
+#endif
+
+// Texto máximo de ssd1306_Marquee e espaço (pixels) entre o fim e o recomeço do texto
+// quando ele é mais largo que a tela e precisa ser rolado por software
+#ifndef SSD1306_MARQUEE_MAX
+#define SSD1306_MARQUEE_MAX     64
+#endif
+#ifndef SSD1306_MARQUEE_GAP
+#define SSD1306_MARQUEE_GAP     16
+#endif
+
+// Cache de textos já rasterizados por ssd1306_WriteString: orçamento de memória
+// (bytes de pixels, fora a tabela de entradas) e quantidade de textos guardados.
+// SSD1306_TEXT_CACHE_BYTES = 0 desliga o cache.
+#ifndef SSD1306_TEXT_CACHE_BYTES
+#define SSD1306_TEXT_CACHE_BYTES    1024
+#endif
+#ifndef SSD1306_TEXT_CACHE_ENTRIES
+#define SSD1306_TEXT_CACHE_ENTRIES  16
+#endif
+
+// Orientação do display padrão em ssd1306_Init (SSD1306_Rotation_t)
+#ifndef SSD1306_ROTATION
+#define SSD1306_ROTATION        SSD1306_ROTATE_0
+#endif
+
+// Texto em retrato (90/270): com 1, as fontes usadas em retrato são giradas
+// inteiras uma vez, no primeiro uso, para um arena de SSD1306_PORTRAIT_GLYPH_BYTES
+// (95 glifos x altura x 2 bytes: 1900 para a 7x10, 3420 para a 11x18). Com 0
+// (padrão, para quem fica em paisagem) o arena não existe e cada caractere em
+// retrato é girado na hora. Ligue junto com SSD1306_ROTATION em 90/270 ou se o
+// programa usa ssd1306_SetRotation para retrato.
+#ifndef SSD1306_PORTRAIT
+#define SSD1306_PORTRAIT        0
+#endif
+#ifndef SSD1306_PORTRAIT_GLYPH_BYTES
+#if SSD1306_PORTRAIT
+#define SSD1306_PORTRAIT_GLYPH_BYTES (95 * 2 * (10 + 18))  // Font_7x10 + Font_11x18
+#else
+#define SSD1306_PORTRAIT_GLYPH_BYTES 0
+#endif
+#endif
+#ifndef SSD1306_PORTRAIT_FONTS
+#define SSD1306_PORTRAIT_FONTS  4
+#endif
+
+// Só textos que não mudam podem ser identificados pelo ponteiro: por padrão os
+// literais e constantes em flash (XIP). Buffers em RAM são sempre redesenhados.
+// No host não há como distinguir literais de buffers, então nada é guardado.
+#ifndef SSD1306_TEXT_CACHEABLE
+#if defined(SSD1306_USE_HOST)
+#define SSD1306_TEXT_CACHEABLE(str) 0
+#else
+#define SSD1306_TEXT_CACHEABLE(str) ((uintptr_t)(str) >= XIP_BASE && (uintptr_t)(str) < SRAM_BASE)
+#endif
+#endif
+
+// Gerenciador de inatividade: tempos padrão (ms) sem atividade até começar a
+// escurecer e até desligar o display (0 = nunca), duração e degraus da rampa de
+// contraste e contraste final. ssd1306_IdleConfig muda os tempos em execução.
+#ifndef SSD1306_IDLE_DIM_MS
+#define SSD1306_IDLE_DIM_MS         30000
+#endif
+#ifndef SSD1306_IDLE_OFF_MS
+#define SSD1306_IDLE_OFF_MS         60000
+#endif
+#ifndef SSD1306_IDLE_RAMP_MS
+#define SSD1306_IDLE_RAMP_MS        2000
+#endif
+#ifndef SSD1306_IDLE_RAMP_STEPS
+#define SSD1306_IDLE_RAMP_STEPS     16
+#endif
+#ifndef SSD1306_IDLE_DIM_CONTRAST
+#define SSD1306_IDLE_DIM_CONTRAST   0x08
+#endif
+
+// Páginas do topo cobertas pela camada de sobreposição (barra de status),
+// composta sobre a tela no envio. 0 desliga a sobreposição.
+#ifndef SSD1306_OVERLAY_PAGES
+#define SSD1306_OVERLAY_PAGES   1
+#endif
+
+// Tamanho máximo de uma sequência de comandos enviada numa única transação
+#ifndef SSD1306_CMD_STREAM_MAX
+#define SSD1306_CMD_STREAM_MAX  40
+#endif
+
+//Cada janela do flush assíncrono gasta 8 palavras de cabeçalho no buffer de
+//envio (controle + 6 comandos + controle dos dados)
+#define SSD1306_TX_WINDOW_WORDS 8
+
+/* Fonte compactada, gerada na compilação por tools/fontpack a partir de src/fonts.c.
+ * Os glifos ficam em colunas verticais de 8 pixels, página a página, no formato
+ * da GDDRAM. Com offsets != NULL as colunas vazias nas bordas de cada glifo são
+ * descartadas; com offsets == NULL todos os glifos têm a largura da fonte. */
+typedef struct {
+    const uint8_t *const columns;    // Bytes dos glifos: [p * colunas + c], bit 0 = linha de cima
+    const uint16_t *const offsets;   // Início de cada glifo em columns (95 + 1 entradas) ou NULL
+    const uint8_t *const first_col;  // Primeira coluna guardada de cada glifo ou NULL
+} SSD1306_PackedFont_t;
+
+/* Estrutura das fonts */
+typedef struct {
+	const uint8_t width;                
+	const uint8_t height;               
+	const uint16_t *const data;         
+    const uint8_t *const char_width;    
+    const SSD1306_PackedFont_t *const packed;
+} SSD1306_Font_t;
+
+/* Letreiro de ssd1306_Marquee (um por display) */
+typedef struct {
+    char text[SSD1306_MARQUEE_MAX + 1];     // Só caracteres 32..126
+    const SSD1306_Font_t *font;
+    uint8_t y;
+    SSD1306_COLOR color;
+    uint16_t width;     // Largura do texto em pixels
+    uint16_t offset;    // Deslocamento atual, só na rolagem por software
+    uint8_t software;   // Rolado por ssd1306_MarqueeTick (texto largo, retrato ou tela redesenhada)
+    uint8_t active;
+} SSD1306_Marquee_t;
+
+/* Gerenciador de inatividade (escurece e desliga o display sem uso) */
+typedef struct {
+    SSD1306_IdleState_t state;
+    uint32_t last_activity;     // ssd1306_Millis da última atividade
+    uint32_t dim_ms;            // Inatividade até começar a escurecer (0 = nunca)
+    uint32_t off_ms;            // Inatividade até desligar (0 = nunca)
+    uint8_t step;               // Passo atual da rampa de contraste (0..SSD1306_IDLE_RAMP_STEPS)
+} SSD1306_Idle_t;
+
+/* Ligação e geometria de um display, para ssd1306_InitDisplay */
+typedef struct {
+    i2c_inst_t *i2c;        // Barramento: i2c0 ou i2c1
+    uint8_t sda_pin;
+    uint8_t scl_pin;
+    uint8_t address;        // Endereço I2C (0x3C ou 0x3D)
+    uint8_t width;          // Colunas (até SSD1306_MAX_WIDTH)
+    uint8_t height;         // Linhas: 32, 64 ou 128 (até SSD1306_MAX_HEIGHT)
+    uint8_t x_offset;       // Primeira coluna do painel na GDDRAM (painéis estreitos)
+    SSD1306_Rotation_t rotation;
+} SSD1306_Config_t;
+
+/* Contexto de um display: barramento, geometria, buffers e estado do flush.
+ * Cada painel ligado à placa tem o seu, em memória estática (zerada); o do
+ * display da placa é criado por ssd1306_Init. As funções de desenho e de envio
+ * agem sobre o contexto selecionado (ssd1306_Select) no núcleo que as chama. */
 typedef struct {
     uint16_t CurrentX;
     uint16_t CurrentY;
     uint8_t Initialized;
     uint8_t DisplayOn;
+    uint8_t Contrast;                        // Contraste pedido (restaurado ao acordar)
+    uint8_t DirtyStart[SSD1306_MAX_PAGES];   // Primeira coluna alterada de cada página
+    uint8_t DirtyEnd[SSD1306_MAX_PAGES];     // Última coluna alterada (Start > End = página limpa)
+    uint8_t ScrollActive;                    // Scroll por hardware ligado (páginas ScrollStart..ScrollEnd)
+    uint8_t ScrollStart;
+    uint8_t ScrollEnd;
+    SSD1306_Marquee_t Marquee;               // Letreiro deste display (ssd1306_Marquee)
+
+    i2c_inst_t *I2c;
+    uint8_t Address;
+    uint8_t Width;
+    uint8_t Height;
+    uint8_t Pages;                           // Height / 8
+    uint8_t XOffset;
+
+    //Orientação: 180 graus sai de graça no hardware (remapeamento de segmentos e
+    //varredura COM); em 90/270 os blitters também trocam x e y. Width/Height são
+    //sempre as do painel; ViewWidth/ViewHeight, as da área de desenho.
+    uint8_t Rotation;                        // SSD1306_Rotation_t
+    bool Transposed;                         // 90/270: x lógico = linha do painel, y = coluna
+    uint8_t ViewWidth;
+    uint8_t ViewHeight;
+
+    //Flush assíncrono: canal de DMA próprio (-1 = ainda não reservado)
+    int DmaChannel;
+#if defined(SSD1306_USE_I2C)
+    dma_channel_config DmaConfig;
+#endif
+    volatile bool FlushPending;              // Há um frame deste display em trânsito
+    void (*FlushCallback)(void);             // Chamado (em interrupção) quando o DMA entrega o frame
+
+    uint32_t BusBytes;                       // Bytes e transações enviados a este display
+    uint32_t BusTransactions;
+    SSD1306_FlushStats_t Stats;
+    SSD1306_Idle_t Idle;
+
+#if SSD1306_OVERLAY_PAGES > 0
+    //Camada de sobreposição (barra de status) nas primeiras SSD1306_OVERLAY_PAGES páginas.
+    //Só existe no envio: cada byte enviado é (tela & ~máscara) | pixels, e o buffer
+    //da tela continua com o conteúdo da tela ativa. Os pixels ficam sempre dentro da máscara.
+    uint8_t OverlayPixels[SSD1306_OVERLAY_PAGES * SSD1306_MAX_WIDTH];
+    uint8_t OverlayMask[SSD1306_OVERLAY_PAGES * SSD1306_MAX_WIDTH];
+    volatile bool OverlayOn;
+    volatile bool OverlayChanged;            // Alterada desde o último flush (pode vir do outro núcleo)
+#endif
+
+    uint8_t Buffer[SSD1306_MAX_BUFFER_SIZE];  // Buffer da tela (Width colunas por página)
+    //Cópia do que foi enviado ao painel (o conteúdo da GDDRAM), para o flush pular
+    //as colunas marcadas como alteradas que voltaram ao mesmo valor. Custa mais
+    //SSD1306_MAX_BUFFER_SIZE bytes de RAM por display (1 KB em 128x64) e um memcpy
+    //das colunas enviadas a cada flush.
+    uint8_t Shown[SSD1306_MAX_BUFFER_SIZE];
+    uint32_t ShownValid;                     // Páginas em que Shown vale (um bit por página)
+    //Buffer de envio (front buffer): cópia do frame em palavras IC_DATA_CMD para o DMA
+    uint16_t TxBuffer[SSD1306_MAX_BUFFER_SIZE + SSD1306_MAX_PAGES * SSD1306_TX_WINDOW_WORDS];
 } SSD1306_t;
 
+/* Sequência de comandos: byte de controle 0x00 seguido de vários comandos */
+typedef struct {
+    uint8_t buf[SSD1306_CMD_STREAM_MAX + 1];
+    uint8_t len;
+} SSD1306_CmdStream_t;
+
 typedef struct {
     uint8_t x;
     uint8_t y;
 } SSD1306_VERTEX;
 
-/* Estrutura das fonts */
+/* Bitmap no formato da GDDRAM (colunas verticais de 8 pixels, página a página),
+ * gerado por tools/bitmappack a partir de src/icons.c */
 typedef struct {
-	const uint8_t width;                
-	const uint8_t height;               
-	const uint16_t *const data;         
-    const uint8_t *const char_width;    
-} SSD1306_Font_t;
+    uint8_t width;
+    uint8_t height;
+    const uint8_t *data;   // Pixels: [p * width + x], bit 0 = linha de cima
+    const uint8_t *mask;   // Pixels desenhados (mesmo formato) ou NULL para o retângulo inteiro
+} SSD1306_Bitmap_t;
+
+/* Como os bits do bitmap são combinados com o buffer da tela */
+typedef enum {
+    SSD1306_BLIT_COPY,    // Opaco: bits 1 acendem e bits 0 apagam
+    SSD1306_BLIT_OR,      // Bits 1 acendem, bits 0 não mudam nada
+    SSD1306_BLIT_ANDNOT,  // Bits 1 apagam, bits 0 não mudam nada
+    SSD1306_BLIT_XOR      // Bits 1 invertem, bits 0 não mudam nada
+} SSD1306_BlitMode_t;
 
 //Protótipo de funções
 void ssd1306_Init(void);
+SSD1306_Error_t ssd1306_InitDisplay(SSD1306_t* dev, const SSD1306_Config_t* config);
+SSD1306_t* ssd1306_Select(SSD1306_t* dev);
+uint8_t ssd1306_GetWidth(void);
+uint8_t ssd1306_GetHeight(void);
+void ssd1306_SetRotation(SSD1306_Rotation_t rotation);
+SSD1306_Rotation_t ssd1306_GetRotation(void);
 void ssd1306_Fill(SSD1306_COLOR color);
 void ssd1306_UpdateScreen(void);
+void ssd1306_UpdateScreenAsync(void);
+void ssd1306_WaitFlush(void);
+bool ssd1306_FlushBusy(void);
+void ssd1306_SetFlushCallback(void (*callback)(void));
 void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color);
 char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color);
 char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color);
 void ssd1306_SetCursor(uint8_t x, uint8_t y);
 void ssd1306_Line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color);
+void ssd1306_HLine(uint8_t x1, uint8_t x2, uint8_t y, SSD1306_COLOR color);
+void ssd1306_VLine(uint8_t x, uint8_t y1, uint8_t y2, SSD1306_COLOR color);
 void ssd1306_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color);
 void ssd1306_DrawArcWithRadiusLine(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color);
 void ssd1306_DrawCircle(uint8_t par_x, uint8_t par_y, uint8_t par_r, SSD1306_COLOR color);
 void ssd1306_FillCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR par_color);
 void ssd1306_Polyline(const SSD1306_VERTEX *par_vertex, uint16_t par_size, SSD1306_COLOR color);
+SSD1306_Error_t ssd1306_FillPolygon(const SSD1306_VERTEX *par_vertex, uint16_t par_size, SSD1306_COLOR color);
 void ssd1306_DrawRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color);
 void ssd1306_FillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color);
 void drawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, SSD1306_COLOR color);
@@ -110,13 +439,39 @@ void teste_display(void);
 void animation_display(void);
 SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8_t w, uint8_t h, SSD1306_COLOR color);
+void ssd1306_BlitBitmap(uint8_t x, uint8_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_BlitMode_t mode);
+void ssd1306_ScrollHorizontal(SSD1306_ScrollDir_t dir, uint8_t start_page, uint8_t end_page, SSD1306_ScrollSpeed_t speed);
+void ssd1306_ScrollDiagonal(SSD1306_ScrollDir_t dir, uint8_t start_page, uint8_t end_page, SSD1306_ScrollSpeed_t speed, uint8_t vertical_offset);
+void ssd1306_ScrollStop(void);
+SSD1306_Error_t ssd1306_Marquee(const char* str, const SSD1306_Font_t* Font, uint8_t page, SSD1306_COLOR color, SSD1306_ScrollSpeed_t speed);
+void ssd1306_MarqueeTick(void);
+void ssd1306_MarqueeStop(void);
+#if SSD1306_OVERLAY_PAGES > 0
+void ssd1306_OverlayEnable(bool on);
+void ssd1306_OverlayClear(uint8_t x1, uint8_t x2);
+void ssd1306_OverlayBlit(uint8_t x, uint8_t page, const SSD1306_Bitmap_t* bitmap);
+void ssd1306_OverlayFlush(void);
+#endif
 void ssd1306_SetContrast(const uint8_t value);
 void ssd1306_SetDisplayOn(const uint8_t on);
 uint8_t ssd1306_GetDisplayOn();
+void ssd1306_IdleConfig(uint32_t dim_ms, uint32_t off_ms);
+void ssd1306_IdleKick(void);
+void ssd1306_IdleTick(void);
+SSD1306_IdleState_t ssd1306_GetIdleState(void);
 void ssd1306_Reset(void);
 void ssd1306_WriteCommand(uint8_t byte);
+void ssd1306_WriteCommands(const uint8_t* stream, size_t len);
+void ssd1306_CmdBegin(SSD1306_CmdStream_t* stream);
+void ssd1306_CmdPush(SSD1306_CmdStream_t* stream, uint8_t cmd);
+void ssd1306_CmdSend(SSD1306_CmdStream_t* stream);
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size);
 SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len);
+void ssd1306_MarkDirty(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+const SSD1306_FlushStats_t* ssd1306_GetFlushStats(void);
+void ssd1306_ReadRow(uint8_t y, uint8_t* out);
+void ssd1306_ReadPage(uint8_t page, uint8_t* out);
+const SSD1306_TextCacheStats_t* ssd1306_GetTextCacheStats(void);
 
 _END_STD_C
 
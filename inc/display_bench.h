@@ -0,0 +1,37 @@
+#ifndef __SSD1306_BENCH_H__
+#define __SSD1306_BENCH_H__
+
+/*
+ * Micro-benchmark das primitivas de desenho do display.
+ *
+ * Roda tanto na placa (bench_main.c, alvo display_bench do CMakeLists.txt
+ * principal) quanto no host (alvo display_bench de tools/CMakeLists.txt, com o
+ * display emulado). Cada primitiva é repetida até somar SSD1306_BENCH_MIN_US e
+ * o resultado sai no stdio como uma tabela CSV, uma linha por primitiva (e por
+ * fonte no caso do texto), para comparar versões:
+ *
+ *   primitive,font,ops,total_us,ns_per_op,cycles_per_op,ops_per_s,pixels_per_s,bytes_flushed,flush_us
+ *
+ * pixels_per_s usa a quantidade nominal de pixels de cada operação (área do
+ * retângulo, comprimento da linha, perímetro do círculo...). bytes_flushed e
+ * flush_us são do ssd1306_UpdateScreen feito logo depois das operações.
+ * cycles_per_op é calculado pelo clk_sys e fica 0 no host.
+ */
+
+#include <stdint.h>
+
+#include "inc/display.h"
+
+// Tempo mínimo medido por primitiva
+#ifndef SSD1306_BENCH_MIN_US
+#define SSD1306_BENCH_MIN_US    200000
+#endif
+
+// Operações entre duas leituras do relógio
+#ifndef SSD1306_BENCH_BATCH
+#define SSD1306_BENCH_BATCH     256
+#endif
+
+void ssd1306_Benchmark(void);
+
+#endif // __SSD1306_BENCH_H__
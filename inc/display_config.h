@@ -2,7 +2,11 @@
 #define __DISPLAY_CONF_H__
 
 // Choose a bus
+// (SSD1306_USE_HOST, definido pelo build do host, troca o I2C por um display
+// emulado em src/display_host.c)
+#ifndef SSD1306_USE_HOST
 #define SSD1306_USE_I2C
+#endif
 //#define SSD1306_USE_SPI
 
 // I2C Configuration
@@ -0,0 +1,71 @@
+#ifndef __SSD1306_HOST_H__
+#define __SSD1306_HOST_H__
+
+/*
+ * Display emulado para o build do host (SSD1306_USE_HOST).
+ *
+ * Recebe os mesmos bytes que iriam para o barramento I2C (byte de controle,
+ * comandos e dados), interpreta os comandos do SSD1306 numa GDDRAM emulada e
+ * grava o que o painel mostraria como imagem PGM ou PNG. Assim display.c, as
+ * fontes e as telas rodam num binário de teste no PC, para comparar com
+ * imagens de referência ou medir desempenho sem a placa. A biblioteca
+ * ssd1306_host de tools/CMakeLists.txt junta tudo isso.
+ *
+ * Cada par barramento + endereço tem o seu display emulado (vários contextos
+ * do driver); as funções de inspeção leem o último selecionado por
+ * ssd1306_HostSelect, que o driver chama a cada transação.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SSD1306_HOST_COLUMNS 128
+#define SSD1306_HOST_PAGES   8
+
+// Displays emulados ao mesmo tempo (um por par barramento + endereço)
+#define SSD1306_HOST_DISPLAYS 4
+
+/* Barramentos I2C do host: só dizem qual display emulado recebe os bytes */
+typedef struct {
+    uint8_t index;
+} i2c_inst_t;
+
+extern i2c_inst_t ssd1306_host_i2c[2];
+#define i2c0 (&ssd1306_host_i2c[0])
+#define i2c1 (&ssd1306_host_i2c[1])
+
+/* Estado do controlador emulado */
+typedef struct {
+    uint8_t gddram[SSD1306_HOST_PAGES][SSD1306_HOST_COLUMNS];
+    uint8_t addressing;          // 0 = horizontal, 1 = vertical, 2 = página
+    uint8_t column, page;        // Ponteiros de escrita
+    uint8_t column_start, column_end;
+    uint8_t page_start, page_end;
+    uint8_t start_line;          // 0x40..0x7F
+    uint8_t display_offset;      // 0xD3
+    uint8_t multiplex;           // 0xA8 (linhas - 1)
+    uint8_t contrast;            // 0x81
+    bool segment_remap;          // 0xA1: coluna 0 à esquerda
+    bool com_reverse;            // 0xC8: linha 0 em cima
+    bool inverted;               // 0xA7
+    bool entire_on;              // 0xA5
+    bool display_on;             // 0xAF
+    bool scroll_active;          // 0x2F
+    uint32_t transactions;       // START..STOP recebidos
+    uint32_t bytes;              // Bytes recebidos (sem o endereço)
+    uint32_t scroll_writes;      // Dados escritos com o scroll ligado (proibido pelo datasheet)
+} SSD1306_HostState_t;
+
+void ssd1306_HostSelect(const i2c_inst_t* bus, uint8_t address);
+void ssd1306_HostReset(void);
+void ssd1306_HostStart(void);
+void ssd1306_HostByte(uint8_t byte);
+void ssd1306_HostStop(void);
+void ssd1306_HostWrite(const uint8_t* bytes, size_t len);
+const SSD1306_HostState_t* ssd1306_HostState(void);
+bool ssd1306_HostPixel(uint8_t x, uint8_t y);
+int ssd1306_HostDumpPGM(const char* path, uint8_t scale);
+int ssd1306_HostDumpPNG(const char* path, uint8_t scale);
+
+#endif // __SSD1306_HOST_H__
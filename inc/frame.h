@@ -0,0 +1,80 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+/*
+ * Agendador de frames das telas que se redesenham sozinhas (animações e
+ * leituras ao vivo).
+ *
+ * Os frames saem numa taxa alvo: frame_Begin dorme até o horário do próximo
+ * frame em vez de desenhar o mais rápido que o barramento deixa. A simulação
+ * anda em passos de tempo fixos, acumulados pelo tempo real (frame_Step), então
+ * a velocidade das animações não depende da taxa de frames nem do I2C. Um
+ * frame que estoura o prazo faz os horários já perdidos serem pulados e
+ * contados como descartados, em vez de uma rajada de frames para alcançá-los.
+ *
+ *   FRAME_Scheduler_t fs;
+ *   frame_Init(&fs, 30, 30000);         // 30 fps, passo de 30 ms
+ *   while (1) {
+ *       frame_Begin(&fs);
+ *       while (frame_Step(&fs)) { ...física... }
+ *       ...desenha...
+ *       ssd1306_UpdateScreenAsync();
+ *       frame_End(&fs);
+ *   }
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Passos de simulação por frame; o atraso além disso é descartado
+// (evita que um travamento longo vire uma sequência de passos sem fim)
+#ifndef FRAME_MAX_STEPS
+#define FRAME_MAX_STEPS 4
+#endif
+
+// Faixas de 1 ms do histograma usado no p99; tempos maiores caem na última
+#ifndef FRAME_HIST_MS
+#define FRAME_HIST_MS   64
+#endif
+
+// Imprime (stdio) as estatísticas quando a tela sai do laço (depuração; sem
+// isso elas continuam disponíveis em frame_GetStats)
+#ifndef FRAME_PRINT_STATS
+#define FRAME_PRINT_STATS 0
+#endif
+
+/* Estatísticas dos frames desde frame_Init */
+typedef struct {
+    uint32_t frames;        // Frames desenhados
+    uint32_t dropped;       // Horários de frame pulados por atraso
+    uint32_t min_us;        // Menor intervalo entre dois frames
+    uint32_t avg_us;        // Intervalo médio
+    uint32_t p99_us;        // Percentil 99 do intervalo (resolução de 1 ms)
+    uint32_t max_us;        // Maior intervalo
+    uint32_t busy_us;       // Tempo médio de trabalho (frame_Begin..frame_End)
+} FRAME_Stats_t;
+
+typedef struct {
+    uint32_t frame_us;      // Período alvo dos frames
+    uint32_t step_us;       // Passo fixo da simulação (0 = sem simulação)
+    uint64_t next_frame;    // Horário do próximo frame
+    uint64_t begin;         // Início do frame atual
+    uint64_t last_begin;    // Início do frame anterior (0 = nenhum)
+    uint64_t accumulator;   // Tempo real ainda não simulado
+    uint32_t frames;
+    uint32_t intervals;     // Intervalos medidos (frames - 1)
+    uint32_t dropped;
+    uint32_t min_us, max_us;
+    uint64_t sum_us;
+    uint64_t busy_sum_us;
+    uint32_t histogram[FRAME_HIST_MS + 1];  // Mesma largura de intervals (16 bits saturava em ~36 min a 30 fps)
+} FRAME_Scheduler_t;
+
+void frame_Init(FRAME_Scheduler_t *fs, uint16_t fps, uint32_t step_us);
+void frame_Begin(FRAME_Scheduler_t *fs);
+bool frame_Step(FRAME_Scheduler_t *fs);
+void frame_End(FRAME_Scheduler_t *fs);
+void frame_GetStats(const FRAME_Scheduler_t *fs, FRAME_Stats_t *stats);
+void frame_PrintStats(const FRAME_Scheduler_t *fs, const char *name);
+
+#endif /* FRAME_H */
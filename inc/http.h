@@ -0,0 +1,139 @@
+#ifndef HTTP_H
+#define HTTP_H
+
+/*
+ * Servidor HTTP/1.1 sobre o lwIP (API raw): leitura das requisições e tabela
+ * de rotas.
+ *
+ * A requisição é lida byte a byte por uma máquina de estados (http_Parse), que
+ * guarda só o que as rotas usam: método, caminho, query string e alguns
+ * cabeçalhos. Ela aceita a requisição em pedaços, então funciona com cadeias
+ * de pbufs e com requisições divididas entre segmentos TCP, e cada byte é
+ * visto uma vez só. Com a requisição completa, o caminho é procurado na tabela
+ * de rotas e o handler correspondente responde.
+ *
+ * A resposta não é montada inteira na memória. O handler escreve o cabeçalho
+ * (http_Begin) e o começo do corpo no buffer pequeno da conexão e indica de
+ * onde vem o resto: um bloco const passado direto ao tcp_write, sem o buffer
+ * (http_WriteRef, as páginas em flash), ou uma função que gera o corpo aos pedaços
+ * (http_WriteStream). O servidor envia só o que cabe em tcp_sndbuf e continua
+ * do callback tcp_sent, conforme o navegador confirma os dados. No fim a
+ * conexão é fechada ou fica aberta para a próxima requisição (keep-alive).
+ *
+ *   static const HTTP_Route_t routes[] = {
+ *       {HTTP_GET, "/",       route_index, NULL},
+ *       {HTTP_GET, "/screen", route_screen, NULL},
+ *   };
+ *   http_Start(80, routes, sizeof(routes) / sizeof(routes[0]));
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lwip/tcp.h"
+
+// Conexões HTTP abertas ao mesmo tempo (uma a mais é recusada)
+#ifndef HTTP_CONNECTIONS
+#define HTTP_CONNECTIONS        MEMP_NUM_TCP_PCB
+#endif
+
+// Tamanhos máximos guardados da requisição (com o terminador)
+#ifndef HTTP_PATH_MAX
+#define HTTP_PATH_MAX           48      // Caminho maior é respondido com 414
+#endif
+#ifndef HTTP_QUERY_MAX
+#define HTTP_QUERY_MAX          32      // Query string maior é respondida com 414
+#endif
+#define HTTP_VALUE_MAX          24      // Valor guardado de um cabeçalho (o resto é descartado)
+#define HTTP_NAME_MAX           20      // Nome de cabeçalho maior que isso é ignorado
+#ifndef HTTP_HEADERS_MAX
+#define HTTP_HEADERS_MAX        4096    // Linha de requisição + cabeçalhos; mais que isso é 431
+#endif
+
+// Buffer de cada conexão: cabeçalho da resposta e pedaços gerados por http_WriteStream
+#ifndef HTTP_BUFFER_SIZE
+#define HTTP_BUFFER_SIZE        512
+#endif
+
+// Conexão keep-alive parada por mais que isso é fechada (libera a posição)
+#ifndef HTTP_IDLE_TIMEOUT_S
+#define HTTP_IDLE_TIMEOUT_S     10
+#endif
+
+// http_Begin sem Content-Length: o corpo termina com o fechamento da conexão
+#define HTTP_LENGTH_UNKNOWN     (-1)
+
+typedef enum {
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_DELETE,
+    HTTP_OTHER
+} HTTP_Method_t;
+
+typedef enum {
+    HTTP_PARSE_MORE,        // Requisição incompleta: faltam bytes
+    HTTP_PARSE_DONE,        // Requisição completa (corpo incluído)
+    HTTP_PARSE_ERROR        // Requisição inválida; status em HTTP_Parser_t
+} HTTP_ParseResult_t;
+
+/* O que as rotas recebem da requisição */
+typedef struct {
+    HTTP_Method_t method;
+    uint8_t version;                    // Versão menor: 0 = HTTP/1.0, 1 = HTTP/1.1
+    bool close;                         // "Connection: close"
+    bool keep_alive;                    // "Connection: keep-alive"
+    uint32_t content_length;
+    char path[HTTP_PATH_MAX];           // Sem a query string
+    char query[HTTP_QUERY_MAX];         // O que vem depois do '?' (vazio = nenhuma)
+    char if_none_match[HTTP_VALUE_MAX];
+} HTTP_Request_t;
+
+/* Estado da leitura de uma requisição */
+typedef struct {
+    HTTP_Request_t request;
+    uint8_t state;
+    uint8_t header;                     // Cabeçalho cujo valor está sendo lido
+    uint16_t status;                    // Status do erro (HTTP_PARSE_ERROR)
+    uint16_t len;                       // Caracteres em token
+    uint16_t size;                      // Bytes lidos da linha de requisição e dos cabeçalhos
+    uint32_t body;                      // Bytes do corpo que ainda faltam
+    char token[HTTP_VALUE_MAX];         // Método, versão, nome ou valor de cabeçalho
+} HTTP_Parser_t;
+
+/* Conexão HTTP aberta (definida em src/http.c) */
+typedef struct HTTP_Conn HTTP_Conn_t;
+
+/* Handler de uma rota: responde pela conexão com http_Begin, http_Write... */
+typedef void (*HTTP_Handler_t)(HTTP_Conn_t *conn, const HTTP_Request_t *request, const void *arg);
+
+/*
+ * Gera o próximo pedaço do corpo em buf (até max bytes). cursor começa em 0 e
+ * guarda entre as chamadas onde a geração parou.
+ *
+ * @return Bytes escritos em buf; 0 termina o corpo.
+ */
+typedef uint16_t (*HTTP_Producer_t)(const void *arg, uint32_t *cursor, uint8_t *buf, uint16_t max);
+
+typedef struct {
+    HTTP_Method_t method;
+    const char *path;                   // Caminho exato, sem query string
+    HTTP_Handler_t handler;
+    const void *arg;                    // Repassado ao handler
+} HTTP_Route_t;
+
+void http_ParserInit(HTTP_Parser_t *parser);
+HTTP_ParseResult_t http_Parse(HTTP_Parser_t *parser, const char *data, uint16_t len, uint16_t *used);
+const char* http_QueryValue(const HTTP_Request_t *request, const char *name);
+bool http_Start(uint16_t port, const HTTP_Route_t *routes, uint8_t count);
+
+// Resposta, na ordem: http_Begin, http_Write (opcional), http_WriteRef ou http_WriteStream (opcional)
+bool http_Begin(HTTP_Conn_t *conn, uint16_t status, const char *content_type, int32_t content_length,
+                const char *headers);
+bool http_Write(HTTP_Conn_t *conn, const void *data, uint16_t len);
+void http_WriteRef(HTTP_Conn_t *conn, const void *data, uint32_t len);
+void http_WriteStream(HTTP_Conn_t *conn, HTTP_Producer_t producer, const void *arg);
+void http_SendError(HTTP_Conn_t *conn, uint16_t status);
+struct tcp_pcb* http_Detach(HTTP_Conn_t *conn);
+
+#endif /* HTTP_H */
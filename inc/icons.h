@@ -1,12 +1,24 @@
 #ifndef ICONS_H
 #define ICONS_H
 
+#include "inc/display.h"
 
 #define NUM_ITEMS  4          ///< Total number of items in the menu.
 #define MAX_ITEM_LENGTH  20   ///< Maximum length of characters allowed for each item name.
 
 extern const unsigned char bitmap_scrollbar_background[];
 extern const unsigned char bitmap_item_sel_outline[];
+extern const unsigned char bitmap_status_wifi[];
+extern const unsigned char bitmap_status_wifi_off[];
+extern const unsigned char bitmap_status_cloud[];
+extern const unsigned char bitmap_status_upload[];
+
+// Versões página a página, geradas por tools/bitmappack (ver CMakeLists.txt)
+extern const SSD1306_Bitmap_t bitmap_item_sel_outline_pages;
+extern const SSD1306_Bitmap_t bitmap_status_wifi_pages;
+extern const SSD1306_Bitmap_t bitmap_status_wifi_off_pages;
+extern const SSD1306_Bitmap_t bitmap_status_cloud_pages;
+extern const SSD1306_Bitmap_t bitmap_status_upload_pages;
 
 
 #endif /* ICONS_H */
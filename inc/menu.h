@@ -17,6 +17,8 @@
 #include "inc/display.h"  // Funções e definições para o display
 #include "inc/fonts.h"    // Definições de fontes para o display
 #include "inc/icons.h"    // Definições de ícones/bitmaps para o display
+#include "inc/ui.h"       // Telas retidas (tabelas de widgets) sobre o display
+#include "inc/frame.h"    // Agendador de frames das telas animadas
 #include "hardware/adc.h" // Interface de hardware para o ADC
 #include "inc/joystick.h" // Funções de interface para o joystick
 #include "inc/buzzer.h"   // Funções para controle do buzzer
@@ -64,10 +66,12 @@
 /*
  * Macros de tempo:
  * - DEBOUNCE: Aguarda 200 ms, usado para debouncing do botão.
- * - POLLING_TIME: Aguarda 10 ms, usado para o delay entre as leituras.
+ * - POLLING_TIME: Aguarda 10 ms, usado para o delay entre as leituras. Antes
+ *   roda idle_poll: inatividade do display e barra de status, já que as telas
+ *   paradas não fazem flush.
  */
 #define DEBOUNCE        sleep_ms(200)
-#define POLLING_TIME    sleep_ms(10)
+#define POLLING_TIME    do { idle_poll(); sleep_ms(10); } while (0)
 
 /*
  * Outras macros de configuração:
@@ -103,5 +107,8 @@ void wifi_screen(void);
 void wifi_home(void);
 float read_temperature_sensor(void);
 void set_adc_channel(uint8_t channel);
+void idle_poll(void);
+bool idle_joystick(uint16_t adc_val);
+bool idle_button(void);
 
 #endif
@@ -0,0 +1,80 @@
+#ifndef UI_H
+#define UI_H
+
+/*
+ * Camada de interface retida sobre o driver do display.
+ *
+ * Cada tela é uma tabela estática de widgets (rótulos, caixas, destaques e
+ * campos de valor). Um widget sabe a própria caixa e se mudou; ui_Render só
+ * apaga e redesenha as regiões alteradas, e o flush envia apenas as páginas
+ * que elas ocupam, em vez de redesenhar e enviar a tela inteira.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "inc/display.h"
+
+// Quantidade máxima de regiões alteradas guardadas entre dois ui_Render.
+// Além disso as regiões são unidas numa só.
+#ifndef UI_MAX_DAMAGE
+#define UI_MAX_DAMAGE 4
+#endif
+
+// Imprime (stdio) o tempo de render e os bytes enviados a cada ui_Render (depuração;
+// sem isso os números continuam em ui_GetFrameStats)
+#ifndef UI_PRINT_STATS
+#define UI_PRINT_STATS 0
+#endif
+
+typedef enum {
+    UI_LABEL,        // Texto fixo em (x, y); caixa calculada pelo texto
+    UI_VALUE,        // Texto variável centralizado na caixa (x, y, w, h)
+    UI_BOX,          // Contorno de retângulo
+    UI_FILL,         // Retângulo preenchido
+    UI_ARROW_LEFT,   // Triângulo preenchido apontando para a esquerda
+    UI_ARROW_RIGHT,  // Triângulo preenchido apontando para a direita
+    UI_HIGHLIGHT     // Bitmap de destaque da seleção, combinado com o que está embaixo
+} UI_WidgetType_t;
+
+/* Retângulo em pixels (x2/y2 inclusivos) */
+typedef struct {
+    uint8_t x1, y1, x2, y2;
+} UI_Rect_t;
+
+typedef struct {
+    UI_WidgetType_t type;
+    uint8_t x, y;                       // Canto superior esquerdo
+    uint8_t w, h;                       // Tamanho (UI_VALUE, UI_BOX, UI_FILL e setas)
+    SSD1306_COLOR color;                // Cor de frente
+    const char *text;                   // UI_LABEL e UI_VALUE
+    const SSD1306_Font_t *font;         // UI_LABEL e UI_VALUE
+    const SSD1306_Bitmap_t *bitmap;     // UI_HIGHLIGHT
+    bool dirty;                         // Mudou desde o último render
+} UI_Widget_t;
+
+typedef struct {
+    UI_Widget_t *widgets;               // Desenhados na ordem da tabela (no máximo 32)
+    uint8_t count;
+    SSD1306_COLOR background;
+    UI_Rect_t damage[UI_MAX_DAMAGE];    // Regiões que precisam ser apagadas e redesenhadas
+    uint8_t damage_count;
+} UI_Screen_t;
+
+/* Custo do último ui_Show/ui_Render */
+typedef struct {
+    uint32_t render_us;     // Tempo de desenho e preparação do flush
+    uint32_t bytes;         // Bytes enviados ao display
+    uint8_t widgets;        // Widgets redesenhados
+} UI_FrameStats_t;
+
+#define UI_SCREEN(table, bg) { (table), sizeof(table) / sizeof((table)[0]), (bg), {{0}}, 0 }
+
+void ui_Show(UI_Screen_t *screen);
+void ui_Render(UI_Screen_t *screen);
+void ui_Invalidate(UI_Screen_t *screen, UI_Widget_t *widget);
+void ui_SetText(UI_Screen_t *screen, UI_Widget_t *widget, const char *text);
+void ui_MoveTo(UI_Screen_t *screen, UI_Widget_t *widget, uint8_t x, uint8_t y);
+const UI_FrameStats_t* ui_GetFrameStats(void);
+
+#endif /* UI_H */
@@ -0,0 +1,30 @@
+#ifndef WEBPAGES_H
+#define WEBPAGES_H
+
+/*
+ * Páginas do servidor HTTP (src/wifi.c).
+ *
+ * Os arquivos de web/ são comprimidos em gzip na compilação por tools/pagepack
+ * e ficam em vetores const, na flash. O servidor os envia como estão, com
+ * "Content-Encoding: gzip", passando-os direto ao tcp_write (http_WriteRef).
+ * Com LWIP_NETIF_TX_SINGLE_PBUF (lwipopts.h) o lwIP copia para o heap o que
+ * está na janela de envio: o custo por requisição está em send_page.
+ */
+
+#include <stdint.h>
+
+typedef struct {
+    const uint8_t *data;        // Arquivo inteiro em gzip
+    uint32_t size;              // Tamanho de data (o que vai no Content-Length)
+    const char *content_type;
+} WEB_Page_t;
+
+extern const WEB_Page_t web_page_index;
+extern const WEB_Page_t web_page_joystick;
+extern const WEB_Page_t web_page_matriz;
+extern const WEB_Page_t web_page_buzzer;
+extern const WEB_Page_t web_page_microfone;
+extern const WEB_Page_t web_page_display;
+extern const WEB_Page_t web_page_wifi;
+
+#endif /* WEBPAGES_H */
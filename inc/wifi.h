@@ -6,6 +6,7 @@
 #include "lwip/tcp.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "hardware/pwm.h"
 #include "hardware/adc.h"
 #include "inc/menu.h"
@@ -16,12 +17,8 @@
 // Variáveis globais
 extern char button1_message[50];
 extern char button2_message[50];
-extern char http_response[8192];
 
 // Protótipos das funções
-void create_http_response(void);
-static err_t http_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
-static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err);
 static void start_http_server(void);
 void create_http_request(void);
 void send_http_request(const void *data, u16_t len);
@@ -31,5 +28,6 @@ void monitor_buttons(void);
 void WIFI_Init(void);
 void WIFI_status(void);
 void webserver_status(void);
+void wifi_status_bar(void);
 
 #endif 
\ No newline at end of file
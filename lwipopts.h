@@ -47,6 +47,10 @@
 #define LWIP_UDP                    1
 #define LWIP_DNS                    1
 #define LWIP_TCP_KEEPALIVE          1
+// Cada quadro sai para o CYW43 num pbuf só, como nos exemplos do pico_w (a
+// saída do driver com cadeias de pbufs apontando para a flash não foi
+// conferida). Com isso tcp_write copia tudo para pbufs no heap (MEM_SIZE),
+// mesmo sem TCP_WRITE_FLAG_COPY: as páginas em flash também (ver send_page).
 #define LWIP_NETIF_TX_SINGLE_PBUF   1
 #define DHCP_DOES_ARP_CHECK         0
 #define LWIP_DHCP_DOES_ACD_CHECK    0
@@ -2,317 +2,2110 @@
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include "math.h"
+#include "inc/display.h"
+#include "inc/frame.h"
+#if defined(SSD1306_USE_I2C)
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
-#include "math.h"
-#include "inc/display.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#elif defined(SSD1306_USE_HOST)
+#include <time.h>
+#endif
 
 //Variável global para indicar que o botão foi pressionado
 volatile bool btn_pressed = false;
 
+//Contexto padrão (display da placa, iniciado por ssd1306_Init) e o contexto
+//selecionado em cada núcleo: cada núcleo desenha no seu sem afetar o outro
+static SSD1306_t SSD1306_Default;
+static SSD1306_t* SSD1306_Current[2] = { &SSD1306_Default, &SSD1306_Default };
+
+//Contextos inicializados (a interrupção do DMA procura neles o canal que terminou)
+static SSD1306_t* SSD1306_Displays[SSD1306_MAX_DISPLAYS];
+
+/* Contexto selecionado no núcleo que está executando */
+static inline SSD1306_t* ssd1306_Dev(void) {
+#if defined(SSD1306_USE_I2C)
+    return SSD1306_Current[get_core_num()];
+#else
+    return SSD1306_Current[0];
+#endif
+}
+
 #if defined(SSD1306_USE_I2C)
 
 const uint8_t I2C_SDA_PIN = 14;
 const uint8_t I2C_SCL_PIN = 15;
 
+//Último contexto que iniciou um flush assíncrono em cada barramento (i2c0, i2c1)
+static SSD1306_t* volatile SSD1306_BusOwner[2];
+
+//Barramentos já configurados (bit 0 = i2c0, bit 1 = i2c1)
+static uint8_t SSD1306_BusReady = 0;
+
+static bool ssd1306_DevFlushBusy(SSD1306_t* dev);
+
 void ssd1306_Reset(void) {
     /* for I2C - do nothing */
 }
 
+/* Milissegundos desde o boot (gerenciador de inatividade) */
+static uint32_t ssd1306_Millis(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
 /**
- * @brief Função para escrever um comando nos registradores do display.
- *  
+ * @brief Configura o I2C e os pinos do display.
+ *
+ * Cada barramento é configurado uma vez; os outros displays ligados a ele só
+ * usam o endereço próprio.
  */
-void ssd1306_WriteCommand(uint8_t byte) {
-    uint8_t buffer[2];           
-    buffer[0] = 0x80;            
-    buffer[1] = byte;            
+static void ssd1306_BusInit(SSD1306_t* dev, const SSD1306_Config_t* config) {
+    const uint8_t bus = i2c_hw_index(dev->I2c);
 
-    i2c_write_blocking(i2c1, SSD1306_I2C_ADDR, buffer, sizeof(buffer), false);
+    if (SSD1306_BusReady & (1u << bus)) {
+        return;
+    }
+    sleep_ms(100);
+
+    i2c_init(dev->I2c, SSD1306_I2C_CLK * 1000);
+    gpio_set_function(config->sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(config->scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(config->sda_pin);
+    gpio_pull_up(config->scl_pin);
+    SSD1306_BusReady |= 1u << bus;
 }
 
 /**
- * @brief Função para enviar um comando nos registradores do display.
+ * @brief Interrupção do DMA: sinaliza o fim da transferência do frame.
  *  
  */
-void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
-    uint8_t temp_buffer[buff_size + 1]; // Buffer temporário
-    temp_buffer[0] = 0x40;             // Endereço do registrador (Control byte)
-    memcpy(&temp_buffer[1], buffer, buff_size); // Copia os dados para o buffer temporário
+static void ssd1306_DmaIrqHandler(void) {
+    for (uint8_t i = 0; i < SSD1306_MAX_DISPLAYS; i++) {
+        SSD1306_t *dev = SSD1306_Displays[i];
+        if (dev && dev->DmaChannel >= 0 && dma_channel_get_irq1_status(dev->DmaChannel)) {
+            dma_channel_acknowledge_irq1(dev->DmaChannel);
+            if (dev->FlushCallback) {
+                dev->FlushCallback();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Aguarda o frame em trânsito no barramento do display, de qualquer contexto.
+ *
+ * Displays em barramentos diferentes não esperam um pelo outro: os flushes
+ * deles correm em paralelo.
+ */
+static void ssd1306_WaitBus(SSD1306_t* dev) {
+    SSD1306_t *owner = SSD1306_BusOwner[i2c_hw_index(dev->I2c)];
 
-    i2c_write_blocking(i2c1, SSD1306_I2C_ADDR, temp_buffer, sizeof(temp_buffer), false);
+    while (owner && ssd1306_DevFlushBusy(owner)) {
+        tight_loop_contents();
+    }
 }
 
-#else
-#error "You should define SSD1306_USE_SPI or SSD1306_USE_I2C macro"
-#endif
+/**
+ * @brief Prepara o controlador I2C para uma escrita direta na FIFO de transmissão.
+ *
+ * Aguarda o frame assíncrono em trânsito no barramento, define o endereço do
+ * display e limpa os indicadores de STOP/abort da transação anterior.
+ */
+static void ssd1306_TxOpen(SSD1306_t* dev) {
+    i2c_hw_t *hw = i2c_get_hw(dev->I2c);
+
+    ssd1306_WaitBus(dev);
+    hw->enable = 0;
+    hw->tar = dev->Address;
+    hw->enable = 1;
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+}
+
+/**
+ * @brief Escreve uma palavra IC_DATA_CMD (byte + bits RESTART/STOP) na FIFO.
+ *  
+ */
+static inline void ssd1306_TxPut(SSD1306_t* dev, uint32_t word) {
+    while (i2c_get_write_available(dev->I2c) == 0) {
+        tight_loop_contents();
+    }
+    i2c_get_hw(dev->I2c)->data_cmd = word;
+}
 
+/**
+ * @brief Aguarda o STOP (ou abort) que encerra a escrita direta.
+ *  
+ */
+static void ssd1306_TxClose(SSD1306_t* dev) {
+    i2c_hw_t *hw = i2c_get_hw(dev->I2c);
 
-//Buffer da tela
-static uint8_t SSD1306_Buffer[SSD1306_BUFFER_SIZE];
+    while (!(hw->raw_intr_stat & (I2C_IC_RAW_INTR_STAT_STOP_DET_BITS | I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS))) {
+        tight_loop_contents();
+    }
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+}
 
-//Criando o objeto display
-static SSD1306_t SSD1306;
+/**
+ * @brief Inicia o envio de um frame já montado em palavras IC_DATA_CMD via DMA.
+ *
+ * Cada palavra carrega o byte nos bits 0..7 e os bits RESTART/STOP do controlador,
+ * por isso o DMA escreve 16 bits por vez direto na FIFO de transmissão do I2C.
+ * Cada contexto tem o seu canal; a interrupção é compartilhada.
+ */
+static void ssd1306_StartTx(SSD1306_t* dev, const uint16_t* words, size_t count) {
+    static bool irq_ready = false;
+    i2c_hw_t *hw = i2c_get_hw(dev->I2c);
+
+    if (dev->DmaChannel < 0) {
+        dev->DmaChannel = dma_claim_unused_channel(true);
+        dev->DmaConfig = dma_channel_get_default_config(dev->DmaChannel);
+        channel_config_set_transfer_data_size(&dev->DmaConfig, DMA_SIZE_16);
+        channel_config_set_read_increment(&dev->DmaConfig, true);
+        channel_config_set_write_increment(&dev->DmaConfig, false);
+        channel_config_set_dreq(&dev->DmaConfig, i2c_get_dreq(dev->I2c, true));
+
+        dma_channel_set_irq1_enabled(dev->DmaChannel, true);
+        if (!irq_ready) {
+            irq_add_shared_handler(DMA_IRQ_1, ssd1306_DmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(DMA_IRQ_1, true);
+            irq_ready = true;
+        }
+    }
 
+    ssd1306_TxOpen(dev);
+    dev->FlushPending = true;
+    SSD1306_BusOwner[i2c_hw_index(dev->I2c)] = dev;
+    dma_channel_configure(dev->DmaChannel, &dev->DmaConfig, &hw->data_cmd, words, count, true);
+}
 
 /**
- * @brief Preenche o Screenbuffer com valores de um buffer fornecido de comprimento fixo.
+ * @brief Retorna true enquanto o último frame assíncrono do contexto ainda está no barramento.
  *  
  */
-SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len) {
-    SSD1306_Error_t ret = SSD1306_ERR;
-    if (len <= SSD1306_BUFFER_SIZE) {
-        memcpy(SSD1306_Buffer,buf,len);
-        ret = SSD1306_OK;
+static bool ssd1306_DevFlushBusy(SSD1306_t* dev) {
+    if (!dev->FlushPending) {
+        return false;
     }
-    return ret;
+    i2c_hw_t *hw = i2c_get_hw(dev->I2c);
+    if (dma_channel_is_busy(dev->DmaChannel) ||
+        !(hw->raw_intr_stat & (I2C_IC_RAW_INTR_STAT_STOP_DET_BITS | I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS))) {
+        return true;
+    }
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+    dev->FlushPending = false;
+    return false;
 }
 
 /**
- * @brief inicializa o display oled.
+ * @brief Retorna true enquanto o último frame assíncrono ainda está no barramento.
  *  
  */
-void ssd1306_Init(void) 
-{
-    ssd1306_Reset();
-    sleep_ms(100);
+bool ssd1306_FlushBusy(void) {
+    return ssd1306_DevFlushBusy(ssd1306_Dev());
+}
 
-    
-    i2c_init(i2c1, SSD1306_I2C_CLK * 1000);
-    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA_PIN);
-    gpio_pull_up(I2C_SCL_PIN);
+/**
+ * @brief Aguarda o fim do frame em trânsito (STOP no barramento).
+ *  
+ */
+void ssd1306_WaitFlush(void) {
+    SSD1306_t *dev = ssd1306_Dev();
 
-    ssd1306_WriteCommand(SSD1306_SET_DISP); 
+    while (ssd1306_DevFlushBusy(dev)) {
+        tight_loop_contents();
+    }
+}
 
-    ssd1306_WriteCommand(0x20); 
-    ssd1306_WriteCommand(0x00); 
-                               
+/**
+ * @brief Define a função chamada quando o DMA termina de entregar um frame.
+ *  
+ */
+void ssd1306_SetFlushCallback(void (*callback)(void)) {
+    ssd1306_Dev()->FlushCallback = callback;
+}
+
+/**
+ * @brief Função para escrever um comando nos registradores do display.
+ *  
+ */
+void ssd1306_WriteCommand(uint8_t byte) {
+    SSD1306_t *dev = ssd1306_Dev();
+    uint8_t buffer[2];           
+    buffer[0] = 0x80;            
+    buffer[1] = byte;            
 
-    ssd1306_WriteCommand(0xB0); 
+    ssd1306_WaitBus(dev);
+    i2c_write_blocking(dev->I2c, dev->Address, buffer, sizeof(buffer), false);
+    dev->BusBytes += sizeof(buffer);
+    dev->BusTransactions++;
+}
 
-#ifdef SSD1306_MIRROR_VERT
-    ssd1306_WriteCommand(0xC0); 
-#else
-    ssd1306_WriteCommand(0xC8); 
-#endif
+/**
+ * @brief Envia uma sequência de comandos já precedida do byte de controle 0x00.
+ *
+ * Com Co=0 e D/C#=0 o display interpreta todos os bytes seguintes como comandos,
+ * então a sequência inteira vai numa única transação I2C.
+ */
+void ssd1306_WriteCommands(const uint8_t* stream, size_t len) {
+    SSD1306_t *dev = ssd1306_Dev();
 
-    ssd1306_WriteCommand(0x00); 
-    ssd1306_WriteCommand(0x10); 
+    ssd1306_WaitBus(dev);
+    i2c_write_blocking(dev->I2c, dev->Address, stream, len, false);
+    dev->BusBytes += len;
+    dev->BusTransactions++;
+}
 
-    ssd1306_WriteCommand(0x40); 
+/**
+ * @brief Função para enviar dados para a GDDRAM do display.
+ *
+ * O byte de controle (0x40) e os dados são escritos direto na FIFO do I2C, sem
+ * montar uma cópia do buffer com o cabeçalho na pilha.
+ */
+void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
+    SSD1306_t *dev = ssd1306_Dev();
 
-    ssd1306_SetContrast(0xFF);
+    if (buff_size == 0) {
+        return;
+    }
+    dev->ShownValid = 0;            // Escrita fora do flush: a cópia do último envio deixa de valer
 
-#ifdef SSD1306_MIRROR_HORIZ
-    ssd1306_WriteCommand(0xA0); 
-#else
-    ssd1306_WriteCommand(0xA1); 
-#endif
+    ssd1306_TxOpen(dev);
+    ssd1306_TxPut(dev, 0x40);        // Endereço do registrador (Control byte)
+    for (size_t i = 0; i < buff_size; i++) {
+        ssd1306_TxPut(dev, buffer[i] | ((i + 1 == buff_size) ? I2C_IC_DATA_CMD_STOP_BITS : 0));
+    }
+    ssd1306_TxClose(dev);
 
-#ifdef SSD1306_INVERSE_COLOR
-    ssd1306_WriteCommand(0xA7); 
-    ssd1306_WriteCommand(0xA6); 
-#endif
+    dev->BusBytes += buff_size + 1;
+    dev->BusTransactions++;
+}
+
+#elif defined(SSD1306_USE_HOST)
+
+/*
+ * Transporte do host: os mesmos bytes e bits de START/STOP que iriam para a
+ * FIFO do I2C são entregues ao display emulado de src/display_host.c (um por
+ * barramento + endereço). O envio "assíncrono" termina na hora, então o flush
+ * nunca fica ocupado.
+ */
+
+// Bits RESTART/STOP das palavras IC_DATA_CMD (mesmos valores do RP2040)
+#define I2C_IC_DATA_CMD_RESTART_BITS 0x00000400u
+#define I2C_IC_DATA_CMD_STOP_BITS    0x00000200u
+
+void ssd1306_Reset(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    ssd1306_HostSelect(dev->I2c, dev->Address);
+    ssd1306_HostReset();
+}
+
+/* Milissegundos do relógio do host (gerenciador de inatividade) */
+static uint32_t ssd1306_Millis(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+}
+
+static void ssd1306_BusInit(SSD1306_t* dev, const SSD1306_Config_t* config) {
+    (void)dev;
+    (void)config;
+}
+
+static void ssd1306_TxOpen(SSD1306_t* dev) {
+    ssd1306_HostSelect(dev->I2c, dev->Address);
+    ssd1306_HostStart();
+}
+
+static inline void ssd1306_TxPut(SSD1306_t* dev, uint32_t word) {
+    (void)dev;
+    if (word & I2C_IC_DATA_CMD_RESTART_BITS) {
+        ssd1306_HostStart();
+    }
+    ssd1306_HostByte(word & 0xFF);
+    if (word & I2C_IC_DATA_CMD_STOP_BITS) {
+        ssd1306_HostStop();
+    }
+}
+
+static void ssd1306_TxClose(SSD1306_t* dev) {
+    (void)dev;
+}
+
+static void ssd1306_StartTx(SSD1306_t* dev, const uint16_t* words, size_t count) {
+    ssd1306_TxOpen(dev);
+    for (size_t i = 0; i < count; i++) {
+        ssd1306_TxPut(dev, words[i]);
+    }
+    if (dev->FlushCallback) {
+        dev->FlushCallback();
+    }
+}
+
+bool ssd1306_FlushBusy(void) {
+    return false;
+}
+
+void ssd1306_WaitFlush(void) {
+}
+
+void ssd1306_SetFlushCallback(void (*callback)(void)) {
+    ssd1306_Dev()->FlushCallback = callback;
+}
+
+void ssd1306_WriteCommand(uint8_t byte) {
+    SSD1306_t *dev = ssd1306_Dev();
+    const uint8_t buffer[2] = { 0x80, byte };
+
+    ssd1306_HostSelect(dev->I2c, dev->Address);
+    ssd1306_HostWrite(buffer, sizeof(buffer));
+    dev->BusBytes += sizeof(buffer);
+    dev->BusTransactions++;
+}
+
+void ssd1306_WriteCommands(const uint8_t* stream, size_t len) {
+    SSD1306_t *dev = ssd1306_Dev();
 
+    ssd1306_HostSelect(dev->I2c, dev->Address);
+    ssd1306_HostWrite(stream, len);
+    dev->BusBytes += len;
+    dev->BusTransactions++;
+}
 
-    ssd1306_WriteCommand(0xA8); 
-    ssd1306_WriteCommand(SSD1306_HEIGHT - 1);
+void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
+    SSD1306_t *dev = ssd1306_Dev();
 
-    ssd1306_WriteCommand(0xA4); 
-    ssd1306_WriteCommand(0xD3); 
-    ssd1306_WriteCommand(0x00); 
+    if (buff_size == 0) {
+        return;
+    }
+    dev->ShownValid = 0;            // Escrita fora do flush: a cópia do último envio deixa de valer
 
-    ssd1306_WriteCommand(0xD5); 
-    ssd1306_WriteCommand(0x80); 
+    ssd1306_TxOpen(dev);
+    ssd1306_TxPut(dev, 0x40);
+    for (size_t i = 0; i < buff_size; i++) {
+        ssd1306_TxPut(dev, buffer[i] | ((i + 1 == buff_size) ? I2C_IC_DATA_CMD_STOP_BITS : 0));
+    }
 
-    ssd1306_WriteCommand(0xD9); 
-    ssd1306_WriteCommand(0xF1); 
+    dev->BusBytes += buff_size + 1;
+    dev->BusTransactions++;
+}
 
-    ssd1306_WriteCommand(0xDA); 
-#if (SSD1306_HEIGHT == 32)
-    ssd1306_WriteCommand(0x02);
-#elif (SSD1306_HEIGHT == 64)
-    ssd1306_WriteCommand(0x12);
-#elif (SSD1306_HEIGHT == 128)
-    ssd1306_WriteCommand(0x12);
 #else
-#error "Only 32, 64, or 128 lines of height are supported!"
+#error "You should define SSD1306_USE_SPI, SSD1306_USE_I2C or SSD1306_USE_HOST macro"
 #endif
 
-    ssd1306_WriteCommand(0xDB);
-    ssd1306_WriteCommand(0x30); 
-    ssd1306_WriteCommand(0x8D); 
-    ssd1306_WriteCommand(0x14); 
-    ssd1306_SetDisplayOn(1); 
 
-    
-    ssd1306_Fill(Black);
-    
-    
-    ssd1306_UpdateScreen();
-    
-    
-    SSD1306.CurrentX = 0;
-    SSD1306.CurrentY = 0;
-    
-    SSD1306.Initialized = 1;
-}
+//Custo em bytes de um frame completo enviado página a página (3 comandos + dados)
+#define SSD1306_FULL_FRAME_BYTES(dev) ((dev)->Pages * (3 * 2 + (dev)->Width + 1))
 
 /**
- * @brief Função que preenche o display com uma cor.
+ * @brief Marca as colunas x1..x2 de uma página como alteradas.
  *  
  */
-void ssd1306_Fill(SSD1306_COLOR color) {
-    memset(SSD1306_Buffer, (color == Black) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
+static inline void ssd1306_DirtyColumns(SSD1306_t* dev, uint8_t page, uint8_t x1, uint8_t x2) {
+    if (x1 < dev->DirtyStart[page]) {
+        dev->DirtyStart[page] = x1;
+    }
+    if (x2 > dev->DirtyEnd[page]) {
+        dev->DirtyEnd[page] = x2;
+    }
 }
 
 /**
- * @brief Função atualiza os buffers do display.
+ * @brief Marca todas as páginas como limpas (nada a enviar no próximo flush).
  *  
  */
-void ssd1306_UpdateScreen(void) {
-    
-    for(uint8_t i = 0; i < SSD1306_HEIGHT/8; i++) {
-        ssd1306_WriteCommand(0xB0 + i); 
-        ssd1306_WriteCommand(0x00 + SSD1306_X_OFFSET_LOWER);
-        ssd1306_WriteCommand(0x10 + SSD1306_X_OFFSET_UPPER);
-        ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*i],SSD1306_WIDTH);
+static void ssd1306_ClearDirty(SSD1306_t* dev) {
+    memset(dev->DirtyStart, 0xFF, sizeof(dev->DirtyStart));
+    memset(dev->DirtyEnd, 0x00, sizeof(dev->DirtyEnd));
+}
+
+/* Marca o retângulo x1..x2, y1..y2 do painel (já ordenado e dentro dele) como alterado */
+static void ssd1306_DirtyRect(SSD1306_t* dev, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+    for (uint8_t page = y1 / 8; page <= y2 / 8; page++) {
+        ssd1306_DirtyColumns(dev, page, x1, x2);
     }
 }
 
 /**
- * @brief Função que desenha um pixel em uma posição especifica do display.
+ * @brief Marca uma região retangular como alterada para o próximo ssd1306_UpdateScreen.
  *  
  */
-void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color) {
-    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
-        
+void ssd1306_MarkDirty(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (x1 >= dev->ViewWidth || y1 >= dev->ViewHeight || x1 > x2 || y1 > y2) {
         return;
     }
-   
- 
-    if(color == White) {
-        SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
-    } else { 
-        SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+    if (x2 >= dev->ViewWidth) {
+        x2 = dev->ViewWidth - 1;
+    }
+    if (y2 >= dev->ViewHeight) {
+        y2 = dev->ViewHeight - 1;
+    }
+    if (dev->Transposed) {
+        ssd1306_DirtyRect(dev, y1, x1, y2, x2);
+    } else {
+        ssd1306_DirtyRect(dev, x1, y1, x2, y2);
     }
 }
 
 /**
- * @brief Função que  escreve um char.
+ * @brief Retorna as estatísticas de bytes enviados/economizados pelo flush.
  *  
  */
-char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color) {
-    uint32_t i, b, j;
+const SSD1306_FlushStats_t* ssd1306_GetFlushStats(void) {
+    SSD1306_t *dev = ssd1306_Dev();
 
-    if (ch < 32 || ch > 126)
-        return 0;
+    return &dev->Stats;
+}
 
-    if (SSD1306_WIDTH < (SSD1306.CurrentX + Font.width) ||
-        SSD1306_HEIGHT < (SSD1306.CurrentY + Font.height))
-    {
+/**
+ * @brief Inicia uma sequência de comandos (byte de controle 0x00 + comandos).
+ *  
+ */
+void ssd1306_CmdBegin(SSD1306_CmdStream_t* stream) {
+    stream->buf[0] = 0x00;
+    stream->len = 1;
+}
 
-        return 0;
+/**
+ * @brief Acrescenta um comando (ou argumento) à sequência.
+ *
+ * Se a sequência encher, ela é enviada e recomeçada automaticamente.
+ */
+void ssd1306_CmdPush(SSD1306_CmdStream_t* stream, uint8_t cmd) {
+    if (stream->len >= sizeof(stream->buf)) {
+        ssd1306_CmdSend(stream);
     }
-    
+    stream->buf[stream->len++] = cmd;
+}
 
-    for(i = 0; i < Font.height; i++) {
-        b = Font.data[(ch - 32) * Font.height + i];
-        for(j = 0; j < Font.width; j++) {
-            if((b << j) & 0x8000)  {
-                ssd1306_DrawPixel(SSD1306.CurrentX + j, (SSD1306.CurrentY + i), (SSD1306_COLOR) color);
-            } else {
-                ssd1306_DrawPixel(SSD1306.CurrentX + j, (SSD1306.CurrentY + i), (SSD1306_COLOR)!color);
-            }
-        }
+/**
+ * @brief Envia a sequência numa única transação I2C e a deixa vazia.
+ *  
+ */
+void ssd1306_CmdSend(SSD1306_CmdStream_t* stream) {
+    if (stream->len > 1) {
+        ssd1306_WriteCommands(stream->buf, stream->len);
     }
-    
-
-    SSD1306.CurrentX += Font.char_width ? Font.char_width[ch - 32] : Font.width;
-
-    return ch;
+    ssd1306_CmdBegin(stream);
 }
 
+
 /**
- * @brief Função que escreve uma strig no display.
+ * @brief Preenche o Screenbuffer com valores de um buffer fornecido de comprimento fixo.
  *  
  */
-char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color) {
-    while (*str) {
-        if (ssd1306_WriteChar(*str, Font, color) != *str) {
-       
-            return *str;
-        }
-        str++;
+SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    SSD1306_Error_t ret = SSD1306_ERR;
+    if (len <= (dev->Width * dev->Pages)) {
+        memcpy(dev->Buffer,buf,len);
+        ssd1306_DirtyRect(dev, 0, 0, dev->Width - 1, dev->Height - 1);
+        ret = SSD1306_OK;
     }
+    return ret;
+}
 
-    return *str;
+/* Guarda a orientação no contexto e calcula a geometria da área de desenho */
+static void ssd1306_SetOrientation(SSD1306_t* dev, SSD1306_Rotation_t rotation) {
+    dev->Rotation = rotation;
+    dev->Transposed = (rotation == SSD1306_ROTATE_90 || rotation == SSD1306_ROTATE_270);
+    dev->ViewWidth = dev->Transposed ? dev->Height : dev->Width;
+    dev->ViewHeight = dev->Transposed ? dev->Width : dev->Height;
 }
 
 /**
- * @brief Função que seta a posição que as informações vão ser escritas.
- *  
+ * @brief Acrescenta o remapeamento de segmentos (0xA0/0xA1) e a varredura COM (0xC0/0xC8) da orientação.
+ *
+ * 180 graus espelha colunas e linhas. Em retrato o buffer já vem transposto e
+ * basta um espelho para completar o giro: colunas em 90 graus, linhas em 270.
+ * SSD1306_MIRROR_HORIZ/VERT (montagem do painel) invertem o resultado.
  */
-void ssd1306_SetCursor(uint8_t x, uint8_t y) 
-{
-    SSD1306.CurrentX = x;
-    SSD1306.CurrentY = y;
+static void ssd1306_OrientationCmds(const SSD1306_t* dev, SSD1306_CmdStream_t* cmd) {
+    bool flip_x = (dev->Rotation == SSD1306_ROTATE_90 || dev->Rotation == SSD1306_ROTATE_180);
+    bool flip_y = (dev->Rotation == SSD1306_ROTATE_180 || dev->Rotation == SSD1306_ROTATE_270);
+
+#ifdef SSD1306_MIRROR_HORIZ
+    flip_x = !flip_x;
+#endif
+#ifdef SSD1306_MIRROR_VERT
+    flip_y = !flip_y;
+#endif
+    ssd1306_CmdPush(cmd, flip_x ? 0xA0 : 0xA1);
+    ssd1306_CmdPush(cmd, flip_y ? 0xC0 : 0xC8);
 }
 
+#if (SSD1306_HEIGHT != 32) && (SSD1306_HEIGHT != 64) && (SSD1306_HEIGHT != 128)
+#error "Only 32, 64, or 128 lines of height are supported!"
+#endif
+
+/**
+ * @brief Inicializa um display e o seu contexto (barramento, endereço e geometria).
+ *
+ * Envia a sequência de inicialização ao painel e o deixa apagado. O contexto
+ * selecionado não muda: para desenhar no novo display use ssd1306_Select.
+ * Retorna SSD1306_ERR se a geometria não for atendida (altura 32, 64 ou 128 até
+ * SSD1306_MAX_HEIGHT, largura até SSD1306_MAX_WIDTH), se o barramento e endereço
+ * já forem de outro contexto ou se já houver SSD1306_MAX_DISPLAYS displays.
+ */
+SSD1306_Error_t ssd1306_InitDisplay(SSD1306_t* dev, const SSD1306_Config_t* config) {
+    uint8_t slot = SSD1306_MAX_DISPLAYS;
+
+    if (dev == NULL || config == NULL || config->i2c == NULL ||
+        config->width == 0 || config->width > SSD1306_MAX_WIDTH || config->height > SSD1306_MAX_HEIGHT ||
+        (config->height != 32 && config->height != 64 && config->height != 128) ||
+        config->rotation > SSD1306_ROTATE_270) {
+        return SSD1306_ERR;
+    }
+    for (uint8_t i = 0; i < SSD1306_MAX_DISPLAYS; i++) {
+        SSD1306_t *other = SSD1306_Displays[i];
+        if (other == dev || (other == NULL && slot == SSD1306_MAX_DISPLAYS)) {
+            slot = i;
+        } else if (other != NULL && other->I2c == config->i2c && other->Address == config->address) {
+            return SSD1306_ERR;    // Endereço já usado por outro contexto
+        }
+    }
+    if (slot == SSD1306_MAX_DISPLAYS) {
+        return SSD1306_ERR;
+    }
+
+    // Na primeira inicialização o contexto ainda não tem canal de DMA
+    if (!dev->Initialized && SSD1306_Displays[slot] != dev) {
+        dev->DmaChannel = -1;
+        dev->FlushPending = false;
+        dev->FlushCallback = NULL;
+    }
+    dev->Initialized = 0;
+    dev->ShownValid = 0;                // GDDRAM com conteúdo desconhecido até o primeiro flush
+    dev->I2c = config->i2c;
+    dev->Address = config->address;
+    dev->Width = config->width;
+    dev->Height = config->height;
+    dev->Pages = config->height / 8;
+    dev->XOffset = config->x_offset;
+    ssd1306_SetOrientation(dev, config->rotation);
+    dev->BusBytes = 0;
+    dev->BusTransactions = 0;
+    memset(&dev->Stats, 0, sizeof(dev->Stats));
+#if SSD1306_OVERLAY_PAGES > 0
+    memset(dev->OverlayPixels, 0, sizeof(dev->OverlayPixels));
+    memset(dev->OverlayMask, 0, sizeof(dev->OverlayMask));
+    dev->OverlayOn = false;
+    dev->OverlayChanged = false;
+#endif
+    SSD1306_Displays[slot] = dev;
+
+    // Os comandos vão para o novo display; a seleção anterior volta no fim
+    SSD1306_t *previous = ssd1306_Select(dev);
+
+    ssd1306_Reset();
+    ssd1306_BusInit(dev, config);
+
+    SSD1306_CmdStream_t cmd;
+    ssd1306_CmdBegin(&cmd);
+
+    ssd1306_CmdPush(&cmd, SSD1306_SET_DISP); 
+    ssd1306_CmdPush(&cmd, 0x2E);    // O scroll continua ligado após um reset só do RP2040
+
+    ssd1306_CmdPush(&cmd, 0x20); 
+    ssd1306_CmdPush(&cmd, 0x00); 
+                               
+
+    ssd1306_CmdPush(&cmd, 0xB0); 
+
+    ssd1306_CmdPush(&cmd, 0x00); 
+    ssd1306_CmdPush(&cmd, 0x10); 
+
+    ssd1306_CmdPush(&cmd, 0x40); 
+
+    ssd1306_CmdPush(&cmd, 0x81);
+    ssd1306_CmdPush(&cmd, 0xFF);
+
+    ssd1306_OrientationCmds(dev, &cmd);
+
+#ifdef SSD1306_INVERSE_COLOR
+    ssd1306_CmdPush(&cmd, 0xA7); 
+    ssd1306_CmdPush(&cmd, 0xA6); 
+#endif
+
+
+    ssd1306_CmdPush(&cmd, 0xA8); 
+    ssd1306_CmdPush(&cmd, dev->Height - 1);
+
+    ssd1306_CmdPush(&cmd, 0xA4); 
+    ssd1306_CmdPush(&cmd, 0xD3); 
+    ssd1306_CmdPush(&cmd, 0x00); 
+
+    ssd1306_CmdPush(&cmd, 0xD5); 
+    ssd1306_CmdPush(&cmd, 0x80); 
+
+    ssd1306_CmdPush(&cmd, 0xD9); 
+    ssd1306_CmdPush(&cmd, 0xF1); 
+
+    // Pinos COM: sequenciais nos painéis de 32 linhas, alternados nos demais
+    ssd1306_CmdPush(&cmd, 0xDA); 
+    ssd1306_CmdPush(&cmd, (dev->Height == 32) ? 0x02 : 0x12);
+
+    ssd1306_CmdPush(&cmd, 0xDB);
+    ssd1306_CmdPush(&cmd, 0x30); 
+    ssd1306_CmdPush(&cmd, 0x8D); 
+    ssd1306_CmdPush(&cmd, 0x14); 
+    ssd1306_CmdPush(&cmd, 0xAF);
+    dev->DisplayOn = 1;
+    dev->ScrollActive = 0;
+    dev->Contrast = 0xFF;
+
+    // Toda a sequência de inicialização vai numa única transação
+    ssd1306_CmdSend(&cmd);
+
+    
+    ssd1306_ClearDirty(dev);
+    ssd1306_Fill(Black);
+    
+    
+    ssd1306_UpdateScreen();
+    
+    
+    dev->CurrentX = 0;
+    dev->CurrentY = 0;
+
+    dev->Idle.state = SSD1306_IDLE_ACTIVE;
+    dev->Idle.dim_ms = SSD1306_IDLE_DIM_MS;
+    dev->Idle.off_ms = SSD1306_IDLE_OFF_MS;
+    dev->Idle.step = 0;
+    dev->Idle.last_activity = ssd1306_Millis();
+    
+    dev->Initialized = 1;
+    ssd1306_Select(previous);
+    return SSD1306_OK;
+}
+
+/**
+ * @brief inicializa o display oled.
+ *
+ * É o display padrão da placa (SSD1306_I2C_PORT, SSD1306_I2C_ADDR,
+ * SSD1306_WIDTH x SSD1306_HEIGHT), usado por todas as funções enquanto nenhum
+ * outro contexto for selecionado.
+ */
+void ssd1306_Init(void) 
+{
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .x_offset = (SSD1306_X_OFFSET_UPPER << 4) | SSD1306_X_OFFSET_LOWER,
+        .rotation = SSD1306_ROTATION,
+    };
+#if defined(SSD1306_USE_I2C)
+    config.sda_pin = I2C_SDA_PIN;
+    config.scl_pin = I2C_SCL_PIN;
+#endif
+
+    ssd1306_InitDisplay(&SSD1306_Default, &config);
+}
+
+/**
+ * @brief Seleciona o display em que o núcleo atual desenha e envia (NULL = padrão).
+ *
+ * A seleção é por núcleo: o outro núcleo continua no display dele (a barra de
+ * status do Wi-Fi, no núcleo 1, segue no display padrão). Retorna o contexto
+ * que estava selecionado, para restaurá-lo depois.
+ */
+SSD1306_t* ssd1306_Select(SSD1306_t* dev) {
+#if defined(SSD1306_USE_I2C)
+    SSD1306_t **current = &SSD1306_Current[get_core_num()];
+#else
+    SSD1306_t **current = &SSD1306_Current[0];
+#endif
+    SSD1306_t *previous = *current;
+
+    *current = dev ? dev : &SSD1306_Default;
+    return previous;
+}
+
+/**
+ * @brief Largura (pixels) da área de desenho do display selecionado.
+ *  
+ */
+uint8_t ssd1306_GetWidth(void) {
+    return ssd1306_Dev()->ViewWidth;
+}
+
+/**
+ * @brief Altura (pixels) da área de desenho do display selecionado.
+ *  
+ */
+uint8_t ssd1306_GetHeight(void) {
+    return ssd1306_Dev()->ViewHeight;
+}
+
+/**
+ * @brief Gira a imagem do display selecionado.
+ *
+ * 0 e 180 graus são feitos pelo controlador, sem custo no desenho. Em 90/270
+ * (retrato) largura e altura se trocam e os blitters passam a escrever o
+ * buffer transposto; ao trocar entre retrato e paisagem a tela deve ser
+ * redesenhada. A tela inteira é reenviada no próximo flush. A sobreposição, o
+ * scroll por hardware e ssd1306_ReadRow/ReadPage continuam nas coordenadas do
+ * painel.
+ */
+void ssd1306_SetRotation(SSD1306_Rotation_t rotation) {
+    SSD1306_t *dev = ssd1306_Dev();
+    SSD1306_CmdStream_t cmd;
+
+    if (rotation > SSD1306_ROTATE_270) {
+        return;
+    }
+    ssd1306_ScrollStop();
+    ssd1306_SetOrientation(dev, rotation);
+    if (dev->CurrentX >= dev->ViewWidth || dev->CurrentY >= dev->ViewHeight) {
+        dev->CurrentX = 0;
+        dev->CurrentY = 0;
+    }
+
+    ssd1306_CmdBegin(&cmd);
+    ssd1306_OrientationCmds(dev, &cmd);
+    ssd1306_CmdSend(&cmd);
+
+    // O remapeamento de segmentos só vale para os dados escritos depois dele
+    dev->ShownValid = 0;
+    ssd1306_DirtyRect(dev, 0, 0, dev->Width - 1, dev->Height - 1);
+}
+
+/**
+ * @brief Orientação atual do display selecionado.
+ *  
+ */
+SSD1306_Rotation_t ssd1306_GetRotation(void) {
+    return (SSD1306_Rotation_t)ssd1306_Dev()->Rotation;
+}
+
+/**
+ * @brief Função que preenche o display com uma cor.
+ *  
+ */
+void ssd1306_Fill(SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    memset(dev->Buffer, (color == Black) ? 0x00 : 0xFF, dev->Width * dev->Pages);
+    ssd1306_DirtyRect(dev, 0, 0, dev->Width - 1, dev->Height - 1);
+}
+
+/* Janela de escrita da GDDRAM usada por um flush: colunas x1..x2, páginas page1..page2 */
+typedef struct {
+    uint8_t x1;
+    uint8_t x2;
+    uint8_t page1;
+    uint8_t page2;
+} SSD1306_Window_t;
+
+#if SSD1306_OVERLAY_PAGES > 0
+/* A página é coberta pela sobreposição ativa */
+static inline bool ssd1306_OverlayPage(SSD1306_t* dev, uint8_t page) {
+    return dev->OverlayOn && page < SSD1306_OVERLAY_PAGES;
+}
+
+/* Byte da tela com a sobreposição por cima (OR dos pixels nos bits da máscara) */
+static inline uint8_t ssd1306_OverlayCompose(SSD1306_t* dev, uint8_t page, uint8_t x, uint8_t byte) {
+    const uint16_t i = page * dev->Width + x;
+    return (byte & ~dev->OverlayMask[i]) | dev->OverlayPixels[i];
+}
+#endif
+
+/* Byte que vai para a coluna x da página: o da tela, com a sobreposição por cima */
+static inline uint8_t ssd1306_PanelByte(SSD1306_t* dev, uint8_t page, uint8_t x) {
+    uint8_t byte = dev->Buffer[page * dev->Width + x];
+#if SSD1306_OVERLAY_PAGES > 0
+    if (ssd1306_OverlayPage(dev, page)) {
+        byte = ssd1306_OverlayCompose(dev, page, x, byte);
+    }
+#endif
+    return byte;
+}
+
+/**
+ * @brief Tira das pontas de cada faixa suja as colunas iguais ao que o painel já tem.
+ *
+ * Telas redesenhadas por inteiro a cada frame (ssd1306_Fill + textos) marcam
+ * tudo como alterado; comparando com a cópia do último envio, só a faixa entre
+ * o primeiro e o último byte que mudou de fato vai para o barramento. Páginas
+ * sem cópia válida (início, rotação, fim de scroll) seguem inteiras.
+ */
+static void ssd1306_TrimDirty(SSD1306_t* dev) {
+    for (uint8_t page = 0; page < dev->Pages; page++) {
+        if (!(dev->ShownValid & (1UL << page))) {
+            continue;
+        }
+        const uint8_t *shown = &dev->Shown[page * dev->Width];
+        uint8_t x1 = dev->DirtyStart[page];
+        uint8_t x2 = dev->DirtyEnd[page];
+
+        while (x1 <= x2 && ssd1306_PanelByte(dev, page, x1) == shown[x1]) {
+            x1++;
+        }
+        while (x2 > x1 && ssd1306_PanelByte(dev, page, x2) == shown[x2]) {
+            x2--;
+        }
+        if (x1 > x2) {
+            dev->DirtyStart[page] = 0xFF;
+            dev->DirtyEnd[page] = 0x00;
+        } else {
+            dev->DirtyStart[page] = x1;
+            dev->DirtyEnd[page] = x2;
+        }
+    }
+}
+
+/**
+ * @brief Registra em Shown o que a janela escreveu na GDDRAM e diz se algum byte mudou.
+ *
+ * Fica fora do laço de envio: fora da sobreposição a faixa enviada é a do
+ * buffer, então cada página custa um memcmp e um memcpy das colunas da janela.
+ * Página escrita inteira passa a ter cópia válida.
+ */
+static bool ssd1306_ShownWindow(SSD1306_t* dev, const SSD1306_Window_t* win) {
+    const uint8_t len = win->x2 - win->x1 + 1;
+    const bool full = (win->x1 == 0 && win->x2 == dev->Width - 1);
+    bool changed = false;
+
+    for (uint8_t page = win->page1; page <= win->page2; page++) {
+        const uint8_t *src = &dev->Buffer[dev->Width*page];
+        uint8_t *shown = &dev->Shown[dev->Width*page];
+        bool same = (dev->ShownValid & (1UL << page)) != 0;
+#if SSD1306_OVERLAY_PAGES > 0
+        if (ssd1306_OverlayPage(dev, page)) {
+            for (uint8_t x = win->x1; x <= win->x2; x++) {
+                const uint8_t byte = ssd1306_OverlayCompose(dev, page, x, src[x]);
+                same = same && shown[x] == byte;
+                shown[x] = byte;
+            }
+            changed |= !same;
+            if (full) {
+                dev->ShownValid |= 1UL << page;
+            }
+            continue;
+        }
+#endif
+        if (!same || memcmp(&shown[win->x1], &src[win->x1], len) != 0) {
+            memcpy(&shown[win->x1], &src[win->x1], len);
+            changed = true;
+        }
+        if (full) {
+            dev->ShownValid |= 1UL << page;
+        }
+    }
+    return changed;
+}
+
+static void ssd1306_MarqueeToSoftware(SSD1306_t* dev);
+static void ssd1306_MarqueeRestore(SSD1306_t* dev);
+
+/**
+ * @brief Agrupa as páginas sujas em janelas de escrita e limpa o estado sujo.
+ *
+ * Páginas sujas vizinhas são unidas numa única janela (0x21/0x22) quando o
+ * número de colunas limpas reenviadas não passa de SSD1306_DIRTY_MERGE_SLACK.
+ * Antes disso as faixas perdem as pontas que não mudaram (ssd1306_TrimDirty).
+ * Retorna a quantidade de janelas (no máximo uma por página).
+ */
+static uint8_t ssd1306_PlanWindows(SSD1306_t* dev, SSD1306_Window_t* windows) {
+    uint8_t count = 0;
+    uint8_t page = 0;
+
+#if SSD1306_OVERLAY_PAGES > 0
+    // Sobreposição alterada: as páginas dela são reenviadas inteiras. A flag é
+    // limpa antes da composição, então uma alteração feita durante o envio
+    // marca o próximo flush.
+    if (dev->OverlayChanged) {
+        dev->OverlayChanged = false;
+        for (page = 0; page < SSD1306_OVERLAY_PAGES; page++) {
+            dev->DirtyStart[page] = 0;
+            dev->DirtyEnd[page] = dev->Width - 1;
+        }
+        page = 0;
+    }
+#endif
+
+    ssd1306_TrimDirty(dev);
+
+    // Com o scroll por hardware ligado a GDDRAM não pode ser escrita (datasheet,
+    // comando 2Fh). Se só a faixa rolada mudou ela é deixada de lado; se há algo
+    // a enviar fora dela, o scroll é desligado antes (ssd1306_ScrollStop marca a
+    // faixa de novo) e o letreiro, se for ele, segue rolando por software.
+    if (dev->ScrollActive) {
+        bool outside = false;
+        for (page = 0; page < dev->Pages; page++) {
+            if ((page < dev->ScrollStart || page > dev->ScrollEnd) &&
+                dev->DirtyStart[page] <= dev->DirtyEnd[page]) {
+                outside = true;
+            }
+        }
+        if (outside) {
+            ssd1306_ScrollStop();
+            ssd1306_MarqueeToSoftware(dev);
+        } else {
+            bool band = false;
+            for (page = dev->ScrollStart; page <= dev->ScrollEnd; page++) {
+                band |= dev->DirtyStart[page] <= dev->DirtyEnd[page];
+            }
+            if (band) {
+                ssd1306_MarqueeRestore(dev);
+            }
+            for (page = dev->ScrollStart; page <= dev->ScrollEnd; page++) {
+                dev->DirtyStart[page] = 0xFF;
+                dev->DirtyEnd[page] = 0x00;
+            }
+        }
+        page = 0;
+    }
+
+    while (page < dev->Pages) {
+        if (dev->DirtyStart[page] > dev->DirtyEnd[page]) {
+            page++;
+            continue;
+        }
+
+        uint8_t first = page;
+        uint8_t last = page;
+        uint8_t x1 = dev->DirtyStart[page];
+        uint8_t x2 = dev->DirtyEnd[page];
+        uint16_t useful = x2 - x1 + 1;
+
+        while ((last + 1) < dev->Pages &&
+               dev->DirtyStart[last + 1] <= dev->DirtyEnd[last + 1]) {
+            uint8_t nx1 = (dev->DirtyStart[last + 1] < x1) ? dev->DirtyStart[last + 1] : x1;
+            uint8_t nx2 = (dev->DirtyEnd[last + 1] > x2) ? dev->DirtyEnd[last + 1] : x2;
+            uint16_t nuseful = useful + dev->DirtyEnd[last + 1] - dev->DirtyStart[last + 1] + 1;
+            uint16_t area = (nx2 - nx1 + 1) * (last + 2 - first);
+            if ((area - nuseful) > SSD1306_DIRTY_MERGE_SLACK) {
+                break;
+            }
+            x1 = nx1;
+            x2 = nx2;
+            useful = nuseful;
+            last++;
+        }
+
+        windows[count].x1 = x1;
+        windows[count].x2 = x2;
+        windows[count].page1 = first;
+        windows[count].page2 = last;
+        count++;
+        page = last + 1;
+    }
+    ssd1306_ClearDirty(dev);
+    return count;
+}
+
+/**
+ * @brief Monta o preâmbulo de uma janela (0x21/0x22) como sequência de comandos.
+ *  
+ */
+static void ssd1306_WindowPreamble(SSD1306_t* dev, SSD1306_CmdStream_t* cmd, const SSD1306_Window_t* win) {
+    ssd1306_CmdBegin(cmd);
+    ssd1306_CmdPush(cmd, 0x21);
+    ssd1306_CmdPush(cmd, win->x1 + dev->XOffset);
+    ssd1306_CmdPush(cmd, win->x2 + dev->XOffset);
+    ssd1306_CmdPush(cmd, 0x22);
+    ssd1306_CmdPush(cmd, win->page1);
+    ssd1306_CmdPush(cmd, win->page2);
+}
+
+/**
+ * @brief Atualiza as estatísticas com os bytes e transações de um frame.
+ *
+ * O número de sequência só avança se algum byte enviado difere do que o painel
+ * mostrava (changed); reenvios iguais (colunas de folga entre faixas,
+ * sobreposição, fim de scroll) não contam como conteúdo novo.
+ */
+static void ssd1306_AccountFrame(SSD1306_t* dev, uint32_t sent, uint32_t transactions, bool changed) {
+    dev->BusBytes += sent;
+    dev->BusTransactions += transactions;
+
+    dev->Stats.frames++;
+    if (changed) {
+        dev->Stats.frame_seq++;
+    }
+    dev->Stats.last_sent = sent;
+    dev->Stats.last_saved = (sent < (uint32_t)SSD1306_FULL_FRAME_BYTES(dev)) ? (SSD1306_FULL_FRAME_BYTES(dev) - sent) : 0;
+    dev->Stats.total_sent += sent;
+    dev->Stats.total_saved += dev->Stats.last_saved;
+    dev->Stats.last_transactions = transactions;
+    dev->Stats.total_transactions = dev->BusTransactions;
+}
+
+/**
+ * @brief Copia uma linha da tela, como o display a mostra, em bits.
+ *
+ * out recebe largura / 8 bytes: bit 7 do primeiro byte = coluna 0 e
+ * bit 1 = pixel aceso, já com a sobreposição por cima. Serve para exportar a
+ * tela linha a linha (espelho HTTP) sem copiar o buffer inteiro; chamada do
+ * outro núcleo, pode pegar um frame no meio do desenho.
+ */
+void ssd1306_ReadRow(uint8_t y, uint8_t* out) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    const uint8_t page = y / 8;
+    const uint8_t bit = 1 << (y % 8);
+    const uint8_t *src = &dev->Buffer[page * dev->Width];
+
+    if (y >= dev->Height) {
+        return;
+    }
+    for (uint8_t i = 0; i < dev->Width / 8; i++) {
+        uint8_t byte = 0;
+        for (uint8_t x = i * 8; x < i * 8 + 8; x++) {
+            uint8_t col = src[x];
+#if SSD1306_OVERLAY_PAGES > 0
+            if (ssd1306_OverlayPage(dev, page)) {
+                col = ssd1306_OverlayCompose(dev, page, x, col);
+            }
+#endif
+            byte = (byte << 1) | ((col & bit) ? 1 : 0);
+        }
+        out[i] = byte;
+    }
+}
+
+/**
+ * @brief Copia uma página (8 linhas) da tela, como o display a mostra.
+ *
+ * Sai no formato do próprio buffer: um byte por coluna, bit 0 na linha de cima,
+ * já com a sobreposição.
+ */
+void ssd1306_ReadPage(uint8_t page, uint8_t* out) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (page >= dev->Height / 8) {
+        return;
+    }
+    memcpy(out, &dev->Buffer[page * dev->Width], dev->Width);
+#if SSD1306_OVERLAY_PAGES > 0
+    if (ssd1306_OverlayPage(dev, page)) {
+        for (uint8_t x = 0; x < dev->Width; x++) {
+            out[x] = ssd1306_OverlayCompose(dev, page, x, out[x]);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Monta no buffer de envio uma janela (0x21/0x22) seguida dos seus dados.
+ *
+ * O preâmbulo da janela é uma sequência de comandos (0x00 + 6 bytes) numa
+ * transação; os dados seguem numa segunda transação aberta com RESTART. A
+ * primeira palavra da janela também leva RESTART, exceto no início do frame.
+ * Marca changed se algum byte difere do que o painel mostrava.
+ */
+static uint16_t* ssd1306_TxWindow(SSD1306_t* dev, uint16_t* w, const SSD1306_Window_t* win, bool* changed) {
+    SSD1306_CmdStream_t cmd;
+    ssd1306_WindowPreamble(dev, &cmd, win);
+
+    for (uint8_t i = 0; i < cmd.len; i++) {
+        w[i] = cmd.buf[i];
+    }
+    if (w != dev->TxBuffer) {
+        w[0] |= I2C_IC_DATA_CMD_RESTART_BITS;
+    }
+    w += cmd.len;
+
+    *w++ = 0x40 | I2C_IC_DATA_CMD_RESTART_BITS;
+    for (uint8_t page = win->page1; page <= win->page2; page++) {
+        const uint8_t *src = &dev->Buffer[dev->Width*page];
+#if SSD1306_OVERLAY_PAGES > 0
+        if (ssd1306_OverlayPage(dev, page)) {
+            for (uint8_t x = win->x1; x <= win->x2; x++) {
+                *w++ = ssd1306_OverlayCompose(dev, page, x, src[x]);
+            }
+            continue;
+        }
+#endif
+        for (uint8_t x = win->x1; x <= win->x2; x++) {
+            *w++ = src[x];
+        }
+    }
+    *changed |= ssd1306_ShownWindow(dev, win);
+    return w;
+}
+
+/**
+ * @brief Inicia o envio do frame atual sem bloquear.
+ *
+ * Copia as colunas alteradas de cada página para o buffer de envio e as transmite
+ * por DMA. O buffer de desenho fica livre logo em seguida, então o próximo frame
+ * pode ser desenhado enquanto este é enviado.
+ */
+void ssd1306_UpdateScreenAsync(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    SSD1306_Window_t windows[SSD1306_MAX_PAGES];
+    uint16_t *w = dev->TxBuffer;
+    bool changed = false;
+
+    // Display dormindo: as alterações ficam marcadas e saem ao acordar
+    if (dev->Idle.state == SSD1306_IDLE_ASLEEP) {
+        ssd1306_AccountFrame(dev, 0, 0, false);
+        return;
+    }
+
+    ssd1306_WaitFlush();
+
+    uint8_t count = ssd1306_PlanWindows(dev, windows);
+    for (uint8_t i = 0; i < count; i++) {
+        w = ssd1306_TxWindow(dev, w, &windows[i], &changed);
+    }
+
+    uint32_t sent = w - dev->TxBuffer;
+    if (sent) {
+        w[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+        ssd1306_StartTx(dev, dev->TxBuffer, sent);
+    }
+    ssd1306_AccountFrame(dev, sent, count * 2, changed);
+}
+
+/**
+ * @brief Função atualiza os buffers do display.
+ *
+ * Versão síncrona: as janelas alteradas são escritas direto do buffer da tela na
+ * FIFO do I2C (mesmo formato do envio assíncrono, sem montar o frame numa cópia)
+ * e a função só retorna depois do STOP no barramento. A única cópia é a das
+ * colunas enviadas para Shown, um memcpy por página depois de cada janela.
+ */
+void ssd1306_UpdateScreen(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    SSD1306_Window_t windows[SSD1306_MAX_PAGES];
+    SSD1306_CmdStream_t cmd;
+    uint32_t sent = 0;
+    bool changed = false;
+
+    // Display dormindo: as alterações ficam marcadas e saem ao acordar
+    if (dev->Idle.state == SSD1306_IDLE_ASLEEP) {
+        ssd1306_AccountFrame(dev, 0, 0, false);
+        return;
+    }
+
+    uint8_t count = ssd1306_PlanWindows(dev, windows);
+    if (count == 0) {
+        ssd1306_AccountFrame(dev, 0, 0, false);
+        return;
+    }
+
+    ssd1306_TxOpen(dev);
+    for (uint8_t i = 0; i < count; i++) {
+        const SSD1306_Window_t *win = &windows[i];
+
+        ssd1306_WindowPreamble(dev, &cmd, win);
+        for (uint8_t k = 0; k < cmd.len; k++) {
+            ssd1306_TxPut(dev, cmd.buf[k] | ((i > 0 && k == 0) ? I2C_IC_DATA_CMD_RESTART_BITS : 0));
+        }
+        ssd1306_TxPut(dev, 0x40 | I2C_IC_DATA_CMD_RESTART_BITS);
+        sent += cmd.len + 1;
+
+        for (uint8_t page = win->page1; page <= win->page2; page++) {
+            const uint8_t *src = &dev->Buffer[dev->Width*page];
+            bool last_page = (i + 1 == count) && (page == win->page2);
+#if SSD1306_OVERLAY_PAGES > 0
+            const bool overlay = ssd1306_OverlayPage(dev, page);
+#else
+            const bool overlay = false;
+#endif
+            for (uint8_t x = win->x1; x <= win->x2; x++) {
+                uint8_t byte = src[x];
+#if SSD1306_OVERLAY_PAGES > 0
+                if (overlay) {
+                    byte = ssd1306_OverlayCompose(dev, page, x, byte);
+                }
+#endif
+                ssd1306_TxPut(dev, byte | ((last_page && x == win->x2) ? I2C_IC_DATA_CMD_STOP_BITS : 0));
+            }
+            sent += win->x2 - win->x1 + 1;
+        }
+        changed |= ssd1306_ShownWindow(dev, win);
+    }
+    ssd1306_TxClose(dev);
+    ssd1306_AccountFrame(dev, sent, count * 2, changed);
+}
+
+/**
+ * @brief Função que desenha um pixel em uma posição especifica do display.
+ *  
+ */
+void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if(x >= dev->ViewWidth || y >= dev->ViewHeight) {
+        
+        return;
+    }
+    if (dev->Transposed) {
+        const uint8_t t = x; x = y; y = t;
+    }
+ 
+    if(color == White) {
+        dev->Buffer[x + (y / 8) * dev->Width] |= 1 << (y % 8);
+    } else { 
+        dev->Buffer[x + (y / 8) * dev->Width] &= ~(1 << (y % 8));
+    }
+    ssd1306_DirtyColumns(dev, y / 8, x, x);
+}
+
+/**
+ * @brief Copia um glifo em colunas verticais para o buffer da tela, byte a byte.
+ *
+ * O glifo guarda apenas as colunas first..first+n-1 da célula de largura w
+ * ([p * n + c], bit 0 na linha de cima); as demais são desenhadas vazias. O
+ * glifo é opaco: bits 1 recebem a cor e bits 0 a cor inversa, como em
+ * ssd1306_WriteChar. Quando y não é múltiplo de 8 cada byte do glifo é dividido
+ * entre duas páginas do buffer. Colunas fora da tela (x negativo ou depois da
+ * borda direita) são descartadas; na vertical o glifo precisa caber inteiro.
+ */
+static void ssd1306_BlitGlyph(SSD1306_t* dev, const uint8_t* glyph, uint8_t first, uint8_t n, uint8_t w, uint8_t h,
+                              int16_t x, uint8_t y, SSD1306_COLOR color) {
+    const uint8_t shift = y % 8;
+    const uint8_t pages = (h + 7) / 8;
+    const int16_t c_start = (x < 0) ? -x : 0;
+    const int16_t c_end = (x + w > dev->Width) ? dev->Width - x : w;
+
+    if (c_start >= c_end) {
+        return;
+    }
+
+    for (uint8_t gp = 0; gp < pages; gp++) {
+        const uint8_t rows = ((h - gp * 8) < 8) ? (h - gp * 8) : 8;
+        const uint8_t valid = (uint8_t)(0xFF >> (8 - rows));
+        const uint8_t page = y / 8 + gp;
+        const uint8_t mask_lo = (uint8_t)(valid << shift);
+        const uint8_t mask_hi = shift ? (uint8_t)(valid >> (8 - shift)) : 0;
+        uint8_t *dst_lo = &dev->Buffer[page * dev->Width];
+        uint8_t *dst_hi = (mask_hi && (page + 1) < dev->Pages) ? dst_lo + dev->Width : NULL;
+        const uint8_t *src = &glyph[gp * n];
+
+        for (int16_t c = c_start; c < c_end; c++) {
+            const uint8_t k = c - first;
+            const uint8_t col = (k < n) ? src[k] : 0;
+            uint8_t bits = (color == White) ? col : (uint8_t)~col;
+            bits &= valid;
+            dst_lo[x + c] = (dst_lo[x + c] & ~mask_lo) | (uint8_t)(bits << shift);
+            if (dst_hi) {
+                dst_hi[x + c] = (dst_hi[x + c] & ~mask_hi) | (uint8_t)(bits >> (8 - shift));
+            }
+        }
+    }
+    ssd1306_DirtyRect(dev, x + c_start, y, x + c_end - 1, y + h - 1);
+}
+
+// Maior altura de glifo girada em retrato (uma linha do glifo = uma coluna do
+// painel); glifos mais altos são desenhados pixel a pixel
+#define SSD1306_PORTRAIT_MAX_ROWS 32
+
+/**
+ * @brief Gira o glifo g para retrato: rows[r] recebe a linha r, bit c = coluna c.
+ *
+ * Cada linha do glifo vira uma coluna do painel, com a coluna 0 do glifo na
+ * linha de cima; é o formato que ssd1306_BlitGlyphPortrait escreve direto nas
+ * páginas. Serve às duas representações das fontes (linhas de 16 bits ou
+ * colunas compactadas por tools/fontpack).
+ */
+static void ssd1306_RotateGlyph(const SSD1306_Font_t* Font, uint32_t g, uint16_t* rows) {
+    const SSD1306_PackedFont_t *packed = Font->packed;
+
+    memset(rows, 0, Font->height * sizeof(uint16_t));
+    if (packed) {
+        const uint8_t pages = (Font->height + 7) / 8;
+        const uint8_t *glyph;
+        uint8_t first = 0, n = Font->width;
+
+        if (packed->offsets) {
+            glyph = &packed->columns[packed->offsets[g]];
+            n = (packed->offsets[g + 1] - packed->offsets[g]) / pages;
+            first = packed->first_col[g];
+        } else {
+            glyph = &packed->columns[g * Font->width * pages];
+        }
+        for (uint8_t gp = 0; gp < pages; gp++) {
+            for (uint8_t k = 0; k < n; k++) {
+                const uint8_t col = glyph[gp * n + k];
+                for (uint8_t b = 0; b < 8 && gp * 8 + b < Font->height; b++) {
+                    if (col & (1 << b)) {
+                        rows[gp * 8 + b] |= 1u << (first + k);
+                    }
+                }
+            }
+        }
+    } else {
+        for (uint8_t r = 0; r < Font->height; r++) {
+            const uint16_t line = Font->data[g * Font->height + r];
+            for (uint8_t c = 0; c < Font->width; c++) {
+                if ((line << c) & 0x8000) {
+                    rows[r] |= 1u << c;
+                }
+            }
+        }
+    }
+}
+
+#if SSD1306_PORTRAIT_GLYPH_BYTES > 0
+
+/* Fonte já girada para retrato: 95 glifos de height linhas no arena */
+typedef struct {
+    const void *font;       // Tabela de glifos da fonte; NULL = livre
+    uint16_t offset;        // Primeira linha em SSD1306_PortraitArena
+} SSD1306_PortraitFont_t;
+
+static uint16_t SSD1306_PortraitArena[SSD1306_PORTRAIT_GLYPH_BYTES / sizeof(uint16_t)];
+static SSD1306_PortraitFont_t SSD1306_PortraitFonts[SSD1306_PORTRAIT_FONTS];
+static uint16_t SSD1306_PortraitUsed = 0;
+
+#endif
+
+/**
+ * @brief Retorna o glifo ch girado para retrato.
+ *
+ * Na primeira vez que uma fonte é usada em retrato ela é girada inteira para o
+ * arena (todas as fontes guardadas são descartadas se faltar espaço); depois
+ * disso cada caractere é só uma leitura. Uma fonte maior que o arena é girada
+ * glifo a glifo em scratch.
+ */
+static const uint16_t* ssd1306_PortraitGlyph(const SSD1306_Font_t* Font, char ch, uint16_t* scratch) {
+    const uint32_t g = ch - 32;
+#if SSD1306_PORTRAIT_GLYPH_BYTES > 0
+    const void *font_key = Font->packed ? (const void*)Font->packed : (const void*)Font->data;
+    const uint16_t glyph_rows = 95 * Font->height;
+    SSD1306_PortraitFont_t *slot = NULL;
+
+    for (uint8_t i = 0; i < SSD1306_PORTRAIT_FONTS; i++) {
+        SSD1306_PortraitFont_t *e = &SSD1306_PortraitFonts[i];
+        if (e->font == font_key) {
+            return &SSD1306_PortraitArena[e->offset + g * Font->height];
+        }
+        if (e->font == NULL && slot == NULL) {
+            slot = e;
+        }
+    }
+    if (glyph_rows <= SSD1306_PORTRAIT_GLYPH_BYTES / sizeof(uint16_t)) {
+        if (slot == NULL || SSD1306_PortraitUsed + glyph_rows > SSD1306_PORTRAIT_GLYPH_BYTES / sizeof(uint16_t)) {
+            memset(SSD1306_PortraitFonts, 0, sizeof(SSD1306_PortraitFonts));
+            SSD1306_PortraitUsed = 0;
+            slot = &SSD1306_PortraitFonts[0];
+        }
+        slot->font = font_key;
+        slot->offset = SSD1306_PortraitUsed;
+        for (uint32_t i = 0; i < 95; i++) {
+            ssd1306_RotateGlyph(Font, i, &SSD1306_PortraitArena[slot->offset + i * Font->height]);
+        }
+        SSD1306_PortraitUsed += glyph_rows;
+        return &SSD1306_PortraitArena[slot->offset + g * Font->height];
+    }
+#endif
+    ssd1306_RotateGlyph(Font, g, scratch);
+    return scratch;
+}
+
+/**
+ * @brief Copia um glifo girado (ssd1306_RotateGlyph) para o buffer em retrato.
+ *
+ * A linha r do glifo é a coluna y + r do painel e os bits dela cobrem as linhas
+ * x..x+w-1 do painel: cada linha do glifo vira no máximo três escritas com
+ * máscara (o trecho atravessa até três páginas). Opaco como ssd1306_BlitGlyph;
+ * x fora da tela é recortado e na vertical o glifo precisa caber inteiro.
+ */
+static void ssd1306_BlitGlyphPortrait(SSD1306_t* dev, const uint16_t* rows, uint8_t w, uint8_t h,
+                                      int16_t x, uint8_t y, SSD1306_COLOR color) {
+    const int16_t c_start = (x < 0) ? -x : 0;
+    const int16_t c_end = (x + w > dev->ViewWidth) ? dev->ViewWidth - x : w;
+
+    if (c_start >= c_end) {
+        return;
+    }
+
+    // Bits das colunas visíveis, alinhados à primeira página tocada
+    const uint8_t page1 = (x + c_start) / 8;
+    const uint8_t page2 = (x + c_end - 1) / 8;
+    const int16_t shift = x - page1 * 8;
+    const uint32_t valid = ((1u << (c_end - c_start)) - 1) << c_start;
+    const uint32_t mask = (shift >= 0) ? valid << shift : valid >> -shift;
+
+    for (uint8_t r = 0; r < h; r++) {
+        const uint32_t line = ((color == White) ? rows[r] : (uint16_t)~rows[r]) & valid;
+        const uint32_t bits = (shift >= 0) ? line << shift : line >> -shift;
+        uint8_t *dst = &dev->Buffer[page1 * dev->Width + y + r];
+
+        for (uint8_t page = page1; page <= page2; page++, dst += dev->Width) {
+            const uint8_t m = (uint8_t)(mask >> ((page - page1) * 8));
+            *dst = (*dst & (uint8_t)~m) | (uint8_t)(bits >> ((page - page1) * 8));
+        }
+    }
+    ssd1306_DirtyRect(dev, y, x + c_start, y + h - 1, x + c_end - 1);
+}
+
+/**
+ * @brief Desenha o glifo pixel a pixel com ssd1306_DrawPixel (frente e fundo).
+ *
+ * Caminho das fontes sem colunas compactadas e dos glifos mais altos que
+ * SSD1306_PORTRAIT_MAX_ROWS em retrato; lê as duas representações das fontes.
+ */
+static void ssd1306_DrawGlyphPixels(SSD1306_t* dev, char ch, const SSD1306_Font_t* Font, int16_t x, uint8_t y, SSD1306_COLOR color) {
+    const SSD1306_PackedFont_t *packed = Font->packed;
+    const uint32_t g = ch - 32;
+    const uint8_t pages = (Font->height + 7) / 8;
+    const uint8_t *glyph = NULL;
+    uint8_t first = 0, n = Font->width;
+
+    if (packed && packed->offsets) {
+        glyph = &packed->columns[packed->offsets[g]];
+        n = (packed->offsets[g + 1] - packed->offsets[g]) / pages;
+        first = packed->first_col[g];
+    } else if (packed) {
+        glyph = &packed->columns[g * Font->width * pages];
+    }
+
+    for (uint32_t i = 0; i < Font->height; i++) {
+        for (uint32_t j = 0; j < Font->width; j++) {
+            if (x + (int32_t)j < 0 || x + (int32_t)j >= dev->ViewWidth) {
+                continue;
+            }
+            bool on;
+            if (glyph) {
+                on = j >= first && j < (uint32_t)(first + n) &&
+                     ((glyph[(i / 8) * n + j - first] >> (i % 8)) & 1);
+            } else {
+                on = (Font->data[g * Font->height + i] << j) & 0x8000;
+            }
+            ssd1306_DrawPixel(x + j, y + i, on ? color : (SSD1306_COLOR)!color);
+        }
+    }
+}
+
+/**
+ * @brief Desenha o caractere ch com o canto superior esquerdo em (x, y), recortando na horizontal.
+ *  
+ */
+static void ssd1306_DrawGlyph(SSD1306_t* dev, char ch, const SSD1306_Font_t* Font, int16_t x, uint8_t y, SSD1306_COLOR color) {
+    const SSD1306_PackedFont_t *packed = Font->packed;
+
+    if (dev->Transposed && Font->height <= SSD1306_PORTRAIT_MAX_ROWS) {
+        uint16_t scratch[SSD1306_PORTRAIT_MAX_ROWS];
+        ssd1306_BlitGlyphPortrait(dev, ssd1306_PortraitGlyph(Font, ch, scratch), Font->width, Font->height, x, y, color);
+    } else if (packed && !dev->Transposed) {
+        const uint8_t pages = (Font->height + 7) / 8;
+        const uint32_t g = ch - 32;
+        const uint8_t *glyph;
+        uint8_t first = 0, n = Font->width;
+
+        if (packed->offsets) {
+            glyph = &packed->columns[packed->offsets[g]];
+            n = (packed->offsets[g + 1] - packed->offsets[g]) / pages;
+            first = packed->first_col[g];
+        } else {
+            glyph = &packed->columns[g * Font->width * pages];
+        }
+        ssd1306_BlitGlyph(dev, glyph, first, n, Font->width, Font->height, x, y, color);
+    } else {
+        // Sem colunas compactadas, ou glifo alto demais para o caminho em retrato
+        ssd1306_DrawGlyphPixels(dev, ch, Font, x, y, color);
+    }
+}
+
+/**
+ * @brief Função que  escreve um char.
+ *  
+ */
+char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (ch < 32 || ch > 126)
+        return 0;
+
+    if (dev->ViewWidth < (dev->CurrentX + Font.width) ||
+        dev->ViewHeight < (dev->CurrentY + Font.height))
+    {
+
+        return 0;
+    }
+    
+    ssd1306_DrawGlyph(dev, ch, &Font, dev->CurrentX, dev->CurrentY, color);
+
+    dev->CurrentX += Font.char_width ? Font.char_width[ch - 32] : Font.width;
+
+    return ch;
+}
+
+#if SSD1306_TEXT_CACHE_BYTES > 0
+
+/* Texto rasterizado guardado no cache: faixa página a página no arena */
+typedef struct {
+    const char *str;        // Texto em flash (o ponteiro identifica o conteúdo); NULL = livre
+    const void *font;       // Tabela de glifos da fonte
+    SSD1306_COLOR color;
+    bool transposed;        // Faixa capturada em retrato (colunas do painel = linhas do texto)
+    uint8_t width;          // Colunas da faixa (no painel)
+    uint8_t height;
+    uint8_t advance;        // Quanto o cursor anda depois do texto
+    uint16_t offset;        // Início da faixa em SSD1306_TextArena
+    uint16_t size;
+    uint32_t last_used;     // Para o descarte LRU
+} SSD1306_TextSprite_t;
+
+static uint8_t SSD1306_TextArena[SSD1306_TEXT_CACHE_BYTES];
+static SSD1306_TextSprite_t SSD1306_TextSprites[SSD1306_TEXT_CACHE_ENTRIES];
+static SSD1306_TextCacheStats_t SSD1306_TextStats;
+static uint32_t SSD1306_TextClock = 0;
+
+/**
+ * @brief Descarta o texto menos usado recentemente. Retorna false se o cache estiver vazio.
+ *  
+ */
+static bool ssd1306_TextEvict(void) {
+    SSD1306_TextSprite_t *lru = NULL;
+
+    for (uint8_t i = 0; i < SSD1306_TEXT_CACHE_ENTRIES; i++) {
+        SSD1306_TextSprite_t *e = &SSD1306_TextSprites[i];
+        if (e->str && (lru == NULL || e->last_used < lru->last_used)) {
+            lru = e;
+        }
+    }
+    if (lru == NULL) {
+        return false;
+    }
+    SSD1306_TextStats.bytes_used -= lru->size;
+    SSD1306_TextStats.evictions++;
+    lru->str = NULL;
+    return true;
+}
+
+/**
+ * @brief Reserva size bytes no fim do arena, descartando textos (LRU) e compactando se preciso.
+ *
+ * As faixas restantes são movidas para o começo do arena na ordem em que estão,
+ * então o espaço livre fica sempre contíguo no fim. Retorna a entrada livre com
+ * offset já preenchido.
+ */
+static SSD1306_TextSprite_t* ssd1306_TextAlloc(uint16_t size) {
+    SSD1306_TextSprite_t *slot = NULL;
+
+    for (;;) {
+        slot = NULL;
+        for (uint8_t i = 0; i < SSD1306_TEXT_CACHE_ENTRIES && slot == NULL; i++) {
+            if (SSD1306_TextSprites[i].str == NULL) {
+                slot = &SSD1306_TextSprites[i];
+            }
+        }
+        if (slot && SSD1306_TextStats.bytes_used + size <= SSD1306_TEXT_CACHE_BYTES) {
+            break;
+        }
+        ssd1306_TextEvict();
+    }
+
+    // Compacta: cada faixa vai para logo depois da anterior, em ordem de offset
+    uint16_t end = 0;
+    for (;;) {
+        SSD1306_TextSprite_t *next = NULL;
+        for (uint8_t i = 0; i < SSD1306_TEXT_CACHE_ENTRIES; i++) {
+            SSD1306_TextSprite_t *e = &SSD1306_TextSprites[i];
+            if (e->str && e->offset >= end && (next == NULL || e->offset < next->offset)) {
+                next = e;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        if (next->offset != end) {
+            memmove(&SSD1306_TextArena[end], &SSD1306_TextArena[next->offset], next->size);
+            next->offset = end;
+        }
+        end += next->size;
+    }
+
+    slot->offset = end;
+    slot->size = size;
+    return slot;
+}
+
+static void ssd1306_BlitPage(SSD1306_t* dev, uint8_t x, uint8_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_BlitMode_t mode);
+
+/**
+ * @brief Copia o retângulo (x, y, width x height) do buffer do painel para uma faixa página a página.
+ *  
+ */
+static void ssd1306_TextCapture(SSD1306_t* dev, uint8_t* dst, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    const uint8_t shift = y % 8;
+    const uint8_t pages = (height + 7) / 8;
+
+    for (uint8_t gp = 0; gp < pages; gp++) {
+        const uint8_t page = y / 8 + gp;
+        const uint8_t *lo = &dev->Buffer[page * dev->Width + x];
+        const uint8_t *hi = (shift && page + 1 < dev->Pages) ? lo + dev->Width : NULL;
+
+        for (uint8_t c = 0; c < width; c++) {
+            uint8_t b = lo[c] >> shift;
+            if (hi) {
+                b |= (uint8_t)(hi[c] << (8 - shift));
+            }
+            *dst++ = b;
+        }
+    }
+}
+
+/**
+ * @brief Desenha str pelo cache de textos. Retorna false se o texto não puder usar o cache.
+ *
+ * Só textos inteiros na tela e com caracteres imprimíveis usam o cache (os outros
+ * param no meio em ssd1306_WriteString). No acerto o texto vira um único
+ * blit opaco; na falta ele é desenhado glifo a glifo e a área desenhada é
+ * copiada do buffer para o arena, no formato da GDDRAM (já transposta em retrato).
+ */
+static bool ssd1306_WriteCached(const char* str, const SSD1306_Font_t* Font, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    const void *font_key = Font->packed ? (const void*)Font->packed : (const void*)Font->data;
+    const uint16_t x = dev->CurrentX;
+    const uint16_t y = dev->CurrentY;
+    uint16_t advance = 0, last = 0;
+
+    if (str[0] == '\0' || y + Font->height > dev->ViewHeight) {
+        return false;
+    }
+    for (const char *p = str; *p; p++) {
+        if (*p < 32 || *p > 126) {
+            return false;
+        }
+        last = advance;
+        advance += Font->char_width ? Font->char_width[*p - 32] : Font->width;
+    }
+    // Como o cursor só avança, basta o último glifo caber na tela
+    const uint16_t width = last + Font->width;
+    if (x + width > dev->ViewWidth) {
+        return false;
+    }
+
+    // A faixa fica nas coordenadas do painel: em retrato x e y se trocam
+    const uint8_t px = dev->Transposed ? y : x;
+    const uint8_t py = dev->Transposed ? x : y;
+    const uint8_t pw = dev->Transposed ? Font->height : width;
+    const uint8_t ph = dev->Transposed ? width : Font->height;
+
+    SSD1306_TextClock++;
+    for (uint8_t i = 0; i < SSD1306_TEXT_CACHE_ENTRIES; i++) {
+        SSD1306_TextSprite_t *e = &SSD1306_TextSprites[i];
+        if (e->str == str && e->font == font_key && e->color == color && e->transposed == dev->Transposed) {
+            const SSD1306_Bitmap_t sprite = { e->width, e->height, &SSD1306_TextArena[e->offset], NULL };
+            ssd1306_BlitPage(dev, px, py, &sprite, SSD1306_BLIT_COPY);
+            dev->CurrentX += e->advance;
+            e->last_used = SSD1306_TextClock;
+            SSD1306_TextStats.hits++;
+            return true;
+        }
+    }
+
+    SSD1306_TextStats.misses++;
+    for (const char *p = str; *p; p++) {
+        ssd1306_WriteChar(*p, *Font, color);
+    }
+
+    const uint16_t size = pw * ((ph + 7) / 8);
+    if (size <= SSD1306_TEXT_CACHE_BYTES && advance <= UINT8_MAX) {
+        SSD1306_TextSprite_t *e = ssd1306_TextAlloc(size);
+        ssd1306_TextCapture(dev, &SSD1306_TextArena[e->offset], px, py, pw, ph);
+        e->str = str;
+        e->font = font_key;
+        e->color = color;
+        e->transposed = dev->Transposed;
+        e->width = pw;
+        e->height = ph;
+        e->advance = advance;
+        e->last_used = SSD1306_TextClock;
+        SSD1306_TextStats.bytes_used += size;
+    }
+    return true;
+}
+
+#endif
+
+/**
+ * @brief Retorna os contadores do cache de textos (acertos, faltas e descartes).
+ *  
+ */
+const SSD1306_TextCacheStats_t* ssd1306_GetTextCacheStats(void) {
+#if SSD1306_TEXT_CACHE_BYTES > 0
+    return &SSD1306_TextStats;
+#else
+    static const SSD1306_TextCacheStats_t empty = { 0 };
+    return &empty;
+#endif
+}
+
+/**
+ * @brief Função que escreve uma strig no display.
+ *
+ * Textos constantes (literais em flash) que cabem inteiros na tela passam pelo
+ * cache de textos: depois da primeira vez são desenhados com um único blit.
+ */
+char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color) {
+#if SSD1306_TEXT_CACHE_BYTES > 0
+    if (SSD1306_TEXT_CACHEABLE(str) && ssd1306_WriteCached(str, &Font, color)) {
+        return '\0';
+    }
+#endif
+    while (*str) {
+        if (ssd1306_WriteChar(*str, Font, color) != *str) {
+       
+            return *str;
+        }
+        str++;
+    }
+
+    return *str;
+}
+
+/**
+ * @brief Função que seta a posição que as informações vão ser escritas.
+ *  
+ */
+void ssd1306_SetCursor(uint8_t x, uint8_t y) 
+{
+    SSD1306_t *dev = ssd1306_Dev();
+
+    dev->CurrentX = x;
+    dev->CurrentY = y;
+}
+
+
+/**
+ * @brief Preenche o retângulo x1..x2, y1..y2 (já ordenado e dentro da tela).
+ *
+ * Trabalha direto nos bytes verticais do buffer: páginas cobertas por inteiro
+ * viram um memset da faixa de colunas e as páginas parciais de cima e de baixo
+ * recebem uma escrita com máscara por coluna. Em retrato o retângulo é o mesmo
+ * com x e y trocados: uma linha horizontal da tela vira um trecho vertical do
+ * painel, preenchido com as mesmas máscaras.
+ */
+static void ssd1306_FillSpan(SSD1306_t* dev, uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2, SSD1306_COLOR color) {
+    if (dev->Transposed) {
+        uint8_t t = x1; x1 = y1; y1 = t;
+        t = x2; x2 = y2; y2 = t;
+    }
+
+    const uint8_t page1 = y1 / 8;
+    const uint8_t page2 = y2 / 8;
+    const size_t len = x2 - x1 + 1;
+
+    for (uint8_t page = page1; page <= page2; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page1) {
+            mask &= (uint8_t)(0xFF << (y1 % 8));
+        }
+        if (page == page2) {
+            mask &= (uint8_t)(0xFF >> (7 - (y2 % 8)));
+        }
+
+        uint8_t *dst = &dev->Buffer[page * dev->Width + x1];
+        if (mask == 0xFF) {
+            memset(dst, (color == White) ? 0xFF : 0x00, len);
+        } else if (color == White) {
+            for (size_t i = 0; i < len; i++) {
+                dst[i] |= mask;
+            }
+        } else {
+            for (size_t i = 0; i < len; i++) {
+                dst[i] &= (uint8_t)~mask;
+            }
+        }
+        ssd1306_DirtyColumns(dev, page, x1, x2);
+    }
+}
+
+/**
+ * @brief Função que desenha uma linha horizontal de x1 a x2 na linha y.
+ *  
+ */
+void ssd1306_HLine(uint8_t x1, uint8_t x2, uint8_t y, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (x1 > x2) {
+        uint8_t t = x1; x1 = x2; x2 = t;
+    }
+    if (y >= dev->ViewHeight || x1 >= dev->ViewWidth) {
+        return;
+    }
+    if (x2 >= dev->ViewWidth) {
+        x2 = dev->ViewWidth - 1;
+    }
+    ssd1306_FillSpan(dev, x1, x2, y, y, color);
+}
+
+/**
+ * @brief Função que desenha uma linha vertical de y1 a y2 na coluna x.
+ *  
+ */
+void ssd1306_VLine(uint8_t x, uint8_t y1, uint8_t y2, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (y1 > y2) {
+        uint8_t t = y1; y1 = y2; y2 = t;
+    }
+    if (x >= dev->ViewWidth || y1 >= dev->ViewHeight) {
+        return;
+    }
+    if (y2 >= dev->ViewHeight) {
+        y2 = dev->ViewHeight - 1;
+    }
+    ssd1306_FillSpan(dev, x, x, y1, y2, color);
+}
+
+/**
+ * @brief Função que desenha uma linha.
+ *  
+ */
+void ssd1306_Line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    if (y1 == y2) {
+        ssd1306_HLine(x1, x2, y1, color);
+        return;
+    }
+    if (x1 == x2) {
+        ssd1306_VLine(x1, y1, y2, color);
+        return;
+    }
+
+    int32_t deltaX = abs(x2 - x1);
+    int32_t deltaY = abs(y2 - y1);
+    int32_t signX = ((x1 < x2) ? 1 : -1);
+    int32_t signY = ((y1 < y2) ? 1 : -1);
+    int32_t error = deltaX - deltaY;
+    int32_t error2;
+    
+    ssd1306_DrawPixel(x2, y2, color);
+
+    while((x1 != x2) || (y1 != y2)) {
+        ssd1306_DrawPixel(x1, y1, color);
+        error2 = error * 2;
+        if(error2 > -deltaY) {
+            error -= deltaY;
+            x1 += signX;
+        }
+        
+        if(error2 < deltaX) {
+            error += deltaX;
+            y1 += signY;
+        }
+    }
+    return;
+}
+
+
+/**
+ * @brief Função que desenha várias linhas.
+ *  
+ */
+void ssd1306_Polyline(const SSD1306_VERTEX *par_vertex, uint16_t par_size, SSD1306_COLOR color) {
+    uint16_t i;
+    if(par_vertex == NULL) {
+        return;
+    }
+
+    for(i = 1; i < par_size; i++) {
+        ssd1306_Line(par_vertex[i - 1].x, par_vertex[i - 1].y, par_vertex[i].x, par_vertex[i].y, color);
+    }
+
+    return;
+}
+
+/* Aresta do preenchimento de polígonos, percorrida linha a linha em ponto fixo 16.16 */
+typedef struct {
+    int32_t x;      // x da aresta na próxima linha (16.16)
+    int32_t slope;  // Variação de x por linha (16.16, arredondada para cima)
+    int16_t y1;     // Primeira linha da aresta (inclusive)
+    int16_t y2;     // Última linha da aresta (exclusive)
+} SSD1306_PolyEdge_t;
+
+/* Divisão arredondada para cima (den > 0) */
+static inline int32_t ssd1306_CeilDiv(int64_t num, int32_t den) {
+    return (int32_t)((num >= 0) ? (num + den - 1) / den : -((-num) / den));
+}
+
+/* Trecho horizontal x1..x2 na linha y, recortado na tela (coordenadas podem estar fora dela) */
+static void ssd1306_ClippedSpan(SSD1306_t* dev, int32_t x1, int32_t x2, int32_t y, SSD1306_COLOR color) {
+    if (x1 > x2) {
+        int32_t t = x1; x1 = x2; x2 = t;
+    }
+    if (y < 0 || y >= dev->ViewHeight || x2 < 0 || x1 >= dev->ViewWidth) {
+        return;
+    }
+    x1 = (x1 < 0) ? 0 : x1;
+    x2 = (x2 >= dev->ViewWidth) ? dev->ViewWidth - 1 : x2;
+    ssd1306_FillSpan(dev, x1, x2, y, y, color);
+}
+
+/**
+ * @brief Preenche um polígono (convexo ou côncavo, regra par-ímpar) por linhas horizontais.
+ *
+ * Cada aresta cobre as linhas [y1, y2) e é percorrida em ponto fixo 16.16; o
+ * passo é arredondado para cima, então x nunca fica abaixo do valor exato e o
+ * truncamento coincide com o da conta exata. Arestas horizontais e vértices
+ * que são o ponto mais baixo das duas arestas vizinhas são desenhados à parte,
+ * para que o polígono inclua a borda de baixo, como o antigo drawFilledTriangle.
+ * As coordenadas podem sair da tela (são recortadas), mas devem ficar entre
+ * -16384 e 16383.
+ */
+static SSD1306_Error_t ssd1306_FillPoly(const int16_t* xs, const int16_t* ys, uint16_t count, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    SSD1306_PolyEdge_t edges[SSD1306_POLY_MAX_VERTICES];
+    int32_t crossings[SSD1306_POLY_MAX_VERTICES];
+    uint16_t edge_count = 0;
+    int32_t ymin = dev->ViewHeight;
+    int32_t ymax = -1;
+
+    if (count < 3 || count > SSD1306_POLY_MAX_VERTICES) {
+        return SSD1306_ERR;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        const uint16_t prev = (i + count - 1) % count;
+        const uint16_t next = (i + 1) % count;
+        uint16_t top = i, bottom = next;
+
+        if (ys[prev] < ys[i] && ys[next] < ys[i]) {
+            ssd1306_ClippedSpan(dev, xs[i], xs[i], ys[i], color);
+        }
+        if (ys[i] == ys[next]) {
+            ssd1306_ClippedSpan(dev, xs[i], xs[next], ys[i], color);
+            continue;
+        }
+        if (ys[i] > ys[next]) {
+            top = next;
+            bottom = i;
+        }
+
+        SSD1306_PolyEdge_t *e = &edges[edge_count];
+        const int32_t dx = xs[bottom] - xs[top];
+        const int32_t dy = ys[bottom] - ys[top];
+        const int32_t first = (ys[top] < 0) ? 0 : ys[top];
+
+        e->slope = ssd1306_CeilDiv((int64_t)dx * 65536, dy);
+        e->x = (int32_t)xs[top] * 65536 + ssd1306_CeilDiv((int64_t)dx * (first - ys[top]) * 65536, dy);
+        e->y1 = first;
+        e->y2 = ys[bottom];
+        if (e->y1 >= e->y2) {
+            continue;
+        }
+        ymin = (e->y1 < ymin) ? e->y1 : ymin;
+        ymax = (e->y2 - 1 > ymax) ? e->y2 - 1 : ymax;
+        edge_count++;
+    }
+    ymax = (ymax >= dev->ViewHeight) ? dev->ViewHeight - 1 : ymax;
+
+    for (int32_t y = ymin; y <= ymax; y++) {
+        uint16_t n = 0;
+
+        // Cruzamentos da linha, em ordem crescente (inserção: são poucos)
+        for (uint16_t i = 0; i < edge_count; i++) {
+            SSD1306_PolyEdge_t *e = &edges[i];
+            if (y < e->y1 || y >= e->y2) {
+                continue;
+            }
+            int32_t cx = e->x >> 16;
+            uint16_t j = n++;
+            while (j > 0 && crossings[j - 1] > cx) {
+                crossings[j] = crossings[j - 1];
+                j--;
+            }
+            crossings[j] = cx;
+            e->x += e->slope;
+        }
+
+        for (uint16_t j = 0; j + 1 < n; j += 2) {
+            ssd1306_ClippedSpan(dev, crossings[j], crossings[j + 1], y, color);
+        }
+    }
+    return SSD1306_OK;
+}
 
 /**
- * @brief Função que desenha uma linha.
+ * @brief Função que preenche um polígono a partir de uma lista de vértices.
  *  
  */
-void ssd1306_Line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
-    int32_t deltaX = abs(x2 - x1);
-    int32_t deltaY = abs(y2 - y1);
-    int32_t signX = ((x1 < x2) ? 1 : -1);
-    int32_t signY = ((y1 < y2) ? 1 : -1);
-    int32_t error = deltaX - deltaY;
-    int32_t error2;
-    
-    ssd1306_DrawPixel(x2, y2, color);
+SSD1306_Error_t ssd1306_FillPolygon(const SSD1306_VERTEX *par_vertex, uint16_t par_size, SSD1306_COLOR color) {
+    int16_t xs[SSD1306_POLY_MAX_VERTICES];
+    int16_t ys[SSD1306_POLY_MAX_VERTICES];
 
-    while((x1 != x2) || (y1 != y2)) {
-        ssd1306_DrawPixel(x1, y1, color);
-        error2 = error * 2;
-        if(error2 > -deltaY) {
-            error -= deltaY;
-            x1 += signX;
-        }
-        
-        if(error2 < deltaX) {
-            error += deltaX;
-            y1 += signY;
-        }
+    if (par_vertex == NULL || par_size > SSD1306_POLY_MAX_VERTICES) {
+        return SSD1306_ERR;
     }
-    return;
+    for (uint16_t i = 0; i < par_size; i++) {
+        xs[i] = par_vertex[i].x;
+        ys[i] = par_vertex[i].y;
+    }
+    return ssd1306_FillPoly(xs, ys, par_size, color);
 }
 
+/* sen(0..90 graus) em ponto fixo Q14 (16384 = 1.0), um valor por grau */
+static const uint16_t SSD1306_SinTable[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
 
 /**
- * @brief Função que desenha várias linhas.
- *  
+ * @brief Seno em Q14 de um ângulo em 1/16 de grau, por tabela e interpolação linear.
+ *
+ * Substitui sinf/cosf: o RP2040 não tem FPU e cada chamada de ponto flutuante
+ * vira uma rotina de software.
  */
-void ssd1306_Polyline(const SSD1306_VERTEX *par_vertex, uint16_t par_size, SSD1306_COLOR color) {
-    uint16_t i;
-    if(par_vertex == NULL) {
-        return;
+static int32_t ssd1306_Sin16(uint32_t angle) {
+    angle %= 360 * 16;
+
+    int32_t sign = 1;
+    if (angle >= 180 * 16) {
+        angle -= 180 * 16;
+        sign = -1;
+    }
+    if (angle > 90 * 16) {
+        angle = 180 * 16 - angle;
     }
 
-    for(i = 1; i < par_size; i++) {
-        ssd1306_Line(par_vertex[i - 1].x, par_vertex[i - 1].y, par_vertex[i].x, par_vertex[i].y, color);
+    const uint32_t idx = angle / 16;
+    const uint32_t frac = angle % 16;
+    int32_t value = SSD1306_SinTable[idx];
+    if (frac) {
+        value += ((SSD1306_SinTable[idx + 1] - value) * (int32_t)frac + 8) / 16;
     }
+    return sign * value;
+}
 
-    return;
+/* Multiplica radius por um valor Q14 e arredonda para o inteiro mais próximo */
+static inline int32_t ssd1306_ScaleQ14(int32_t value, uint8_t radius) {
+    int32_t v = value * radius;
+    return (v >= 0) ? ((v + 8192) >> 14) : -((-v + 8192) >> 14);
+}
+
+/* Ponto do arco no ângulo angle (1/16 de grau): 0 aponta para baixo, crescendo no sentido anti-horário */
+static inline void ssd1306_ArcPoint(uint8_t x, uint8_t y, uint8_t radius, uint32_t angle, uint8_t* xp, uint8_t* yp) {
+    *xp = x + (int8_t)ssd1306_ScaleQ14(ssd1306_Sin16(angle), radius);
+    *yp = y + (int8_t)ssd1306_ScaleQ14(ssd1306_Sin16(angle + 90 * 16), radius);
 }
 
-static float ssd1306_DegToRad(float par_deg) {
-    return par_deg * (3.14f / 180.0f);
+/* Ângulo do segmento k do arco: k * sweep / segments graus, em 1/16 de grau */
+static inline uint32_t ssd1306_ArcAngle(uint32_t k, uint32_t sweep, uint32_t segments) {
+    return segments ? (k * sweep * 16) / segments : 0;
 }
 
 static uint16_t ssd1306_NormalizeTo0_360(uint16_t par_deg) {
@@ -326,81 +2119,50 @@ static uint16_t ssd1306_NormalizeTo0_360(uint16_t par_deg) {
     return loc_angle;
 }
 
-
-void ssd1306_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
-    static const uint8_t CIRCLE_APPROXIMATION_SEGMENTS = 36;
-    float approx_degree;
-    uint32_t approx_segments;
-    uint8_t xp1,xp2;
-    uint8_t yp1,yp2;
-    uint32_t count;
-    uint32_t loc_sweep;
-    float rad;
-    
-    loc_sweep = ssd1306_NormalizeTo0_360(sweep);
-    
-    count = (ssd1306_NormalizeTo0_360(start_angle) * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_segments = (loc_sweep * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_degree = loc_sweep / (float)approx_segments;
-    while(count < approx_segments)
-    {
-        rad = ssd1306_DegToRad(count*approx_degree);
-        xp1 = x + (int8_t)(sinf(rad)*radius);
-        yp1 = y + (int8_t)(cosf(rad)*radius);    
+/**
+ * @brief Desenha o arco como segmentos de reta de ~10 graus, só com inteiros.
+ *
+ * Guarda em first e last os pontos inicial e final do arco (usados pelas linhas
+ * de raio em ssd1306_DrawArcWithRadiusLine).
+ */
+static void ssd1306_ArcSegments(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep,
+                                SSD1306_COLOR color, SSD1306_VERTEX* first, SSD1306_VERTEX* last) {
+    static const uint32_t CIRCLE_APPROXIMATION_SEGMENTS = 36;
+    const uint32_t loc_sweep = ssd1306_NormalizeTo0_360(sweep);
+    const uint32_t approx_segments = (loc_sweep * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
+    uint32_t count = (ssd1306_NormalizeTo0_360(start_angle) * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
+    uint8_t xp1, yp1, xp2, yp2;
+
+    ssd1306_ArcPoint(x, y, radius, ssd1306_ArcAngle(count, loc_sweep, approx_segments), &xp2, &yp2);
+    first->x = xp2;
+    first->y = yp2;
+    while (count < approx_segments) {
+        xp1 = xp2;
+        yp1 = yp2;
         count++;
-        if(count != approx_segments) {
-            rad = ssd1306_DegToRad(count*approx_degree);
-        } else {
-            rad = ssd1306_DegToRad(loc_sweep);
-        }
-        xp2 = x + (int8_t)(sinf(rad)*radius);
-        yp2 = y + (int8_t)(cosf(rad)*radius);    
-        ssd1306_Line(xp1,yp1,xp2,yp2,color);
+        ssd1306_ArcPoint(x, y, radius, ssd1306_ArcAngle(count, loc_sweep, approx_segments), &xp2, &yp2);
+        ssd1306_Line(xp1, yp1, xp2, yp2, color);
     }
-    
+    last->x = xp2;
+    last->y = yp2;
+}
+
+void ssd1306_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
+    SSD1306_VERTEX first, last;
+
+    ssd1306_ArcSegments(x, y, radius, start_angle, sweep, color, &first, &last);
     return;
 }
 
 
 void ssd1306_DrawArcWithRadiusLine(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
-    const uint32_t CIRCLE_APPROXIMATION_SEGMENTS = 36;
-    float approx_degree;
-    uint32_t approx_segments;
-    uint8_t xp1;
-    uint8_t xp2 = 0;
-    uint8_t yp1;
-    uint8_t yp2 = 0;
-    uint32_t count;
-    uint32_t loc_sweep;
-    float rad;
-    
-    loc_sweep = ssd1306_NormalizeTo0_360(sweep);
-    
-    count = (ssd1306_NormalizeTo0_360(start_angle) * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_segments = (loc_sweep * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_degree = loc_sweep / (float)approx_segments;
+    SSD1306_VERTEX first, last;
 
-    rad = ssd1306_DegToRad(count*approx_degree);
-    uint8_t first_point_x = x + (int8_t)(sinf(rad)*radius);
-    uint8_t first_point_y = y + (int8_t)(cosf(rad)*radius);   
-    while (count < approx_segments) {
-        rad = ssd1306_DegToRad(count*approx_degree);
-        xp1 = x + (int8_t)(sinf(rad)*radius);
-        yp1 = y + (int8_t)(cosf(rad)*radius);    
-        count++;
-        if (count != approx_segments) {
-            rad = ssd1306_DegToRad(count*approx_degree);
-        } else {
-            rad = ssd1306_DegToRad(loc_sweep);
-        }
-        xp2 = x + (int8_t)(sinf(rad)*radius);
-        yp2 = y + (int8_t)(cosf(rad)*radius);    
-        ssd1306_Line(xp1,yp1,xp2,yp2,color);
-    }
+    ssd1306_ArcSegments(x, y, radius, start_angle, sweep, color, &first, &last);
     
     // Radius line
-    ssd1306_Line(x,y,first_point_x,first_point_y,color);
-    ssd1306_Line(x,y,xp2,yp2,color);
+    ssd1306_Line(x,y,first.x,first.y,color);
+    ssd1306_Line(x,y,last.x,last.y,color);
     return;
 }
 
@@ -409,12 +2171,14 @@ void ssd1306_DrawArcWithRadiusLine(uint8_t x, uint8_t y, uint8_t radius, uint16_
  *  
  */
 void ssd1306_DrawCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR par_color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
     int32_t x = -par_r;
     int32_t y = 0;
     int32_t err = 2 - 2 * par_r;
     int32_t e2;
 
-    if (par_x >= SSD1306_WIDTH || par_y >= SSD1306_HEIGHT) {
+    if (par_x >= dev->ViewWidth || par_y >= dev->ViewHeight) {
         return;
     }
 
@@ -447,20 +2211,32 @@ void ssd1306_DrawCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR
  *  
  */
 void ssd1306_FillCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR par_color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
     int32_t x = -par_r;
     int32_t y = 0;
     int32_t err = 2 - 2 * par_r;
     int32_t e2;
+    int32_t last_y = -1;
 
-    if (par_x >= SSD1306_WIDTH || par_y >= SSD1306_HEIGHT) {
+    if (par_x >= dev->ViewWidth || par_y >= dev->ViewHeight) {
         return;
     }
 
     do {
-        for (uint8_t _y = (par_y + y); _y >= (par_y - y); _y--) {
-            for (uint8_t _x = (par_x - x); _x >= (par_x + x); _x--) {
-                ssd1306_DrawPixel(_x, _y, par_color);
+        // Primeiro ponto de cada linha é o mais largo: vira um span em cima e outro embaixo
+        if (y != last_y) {
+            int32_t x1 = par_x + x;
+            int32_t x2 = par_x - x;
+            x1 = (x1 < 0) ? 0 : x1;
+            x2 = (x2 >= dev->ViewWidth) ? dev->ViewWidth - 1 : x2;
+            if (par_y + y < dev->ViewHeight) {
+                ssd1306_HLine(x1, x2, par_y + y, par_color);
+            }
+            if (y > 0 && par_y - y >= 0) {
+                ssd1306_HLine(x1, x2, par_y - y, par_color);
             }
+            last_y = y;
         }
 
         e2 = err;
@@ -486,10 +2262,10 @@ void ssd1306_FillCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR
  *  
  */
 void ssd1306_DrawRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
-    ssd1306_Line(x1,y1,x2,y1,color);
-    ssd1306_Line(x2,y1,x2,y2,color);
-    ssd1306_Line(x2,y2,x1,y2,color);
-    ssd1306_Line(x1,y2,x1,y1,color);
+    ssd1306_HLine(x1, x2, y1, color);
+    ssd1306_VLine(x2, y1, y2, color);
+    ssd1306_HLine(x1, x2, y2, color);
+    ssd1306_VLine(x1, y1, y2, color);
 
     return;
 }
@@ -499,16 +2275,23 @@ void ssd1306_DrawRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD13
  *  
  */
 void ssd1306_FillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
     uint8_t x_start = ((x1<=x2) ? x1 : x2);
     uint8_t x_end   = ((x1<=x2) ? x2 : x1);
     uint8_t y_start = ((y1<=y2) ? y1 : y2);
     uint8_t y_end   = ((y1<=y2) ? y2 : y1);
 
-    for (uint8_t y= y_start; (y<= y_end)&&(y<SSD1306_HEIGHT); y++) {
-        for (uint8_t x= x_start; (x<= x_end)&&(x<SSD1306_WIDTH); x++) {
-            ssd1306_DrawPixel(x, y, color);
-        }
+    if (x_start >= dev->ViewWidth || y_start >= dev->ViewHeight) {
+        return;
+    }
+    if (x_end >= dev->ViewWidth) {
+        x_end = dev->ViewWidth - 1;
     }
+    if (y_end >= dev->ViewHeight) {
+        y_end = dev->ViewHeight - 1;
+    }
+    ssd1306_FillSpan(dev, x_start, x_end, y_start, y_end, color);
     return;
 }
 
@@ -517,7 +2300,9 @@ void ssd1306_FillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD13
  *  
  */
 SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
-  if((x2 >= SSD1306_WIDTH) || (y2 >= SSD1306_HEIGHT)) 
+    SSD1306_t *dev = ssd1306_Dev();
+
+  if((x2 >= dev->ViewWidth) || (y2 >= dev->ViewHeight)) 
   {
     return SSD1306_ERR;
   }
@@ -525,27 +2310,33 @@ SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint
   {
     return SSD1306_ERR;
   }
+  if (dev->Transposed)
+  {
+    uint8_t t = x1; x1 = y1; y1 = t;
+    t = x2; x2 = y2; y2 = t;
+  }
+  ssd1306_DirtyRect(dev, x1, y1, x2, y2);
   uint32_t i;
   if ((y1 / 8) != (y2 / 8)) 
   {    
     for(uint32_t x = x1; x <= x2; x++) 
     {
-      i = x + (y1 / 8) * SSD1306_WIDTH;
-      SSD1306_Buffer[i] ^= 0xFF << (y1 % 8);
-      i += SSD1306_WIDTH;
-      for (; i < x + (y2 / 8) * SSD1306_WIDTH; i += SSD1306_WIDTH) {
-        SSD1306_Buffer[i] ^= 0xFF;
+      i = x + (y1 / 8) * dev->Width;
+      dev->Buffer[i] ^= 0xFF << (y1 % 8);
+      i += dev->Width;
+      for (; i < x + (y2 / 8) * dev->Width; i += dev->Width) {
+        dev->Buffer[i] ^= 0xFF;
       }
-      SSD1306_Buffer[i] ^= 0xFF >> (7 - (y2 % 8));
+      dev->Buffer[i] ^= 0xFF >> (7 - (y2 % 8));
     }
   } 
   else 
   {
     
     const uint8_t mask = (0xFF << (y1 % 8)) & (0xFF >> (7 - (y2 % 8)));
-    for (i = x1 + (y1 / 8) * SSD1306_WIDTH;
-         i <= (uint32_t)x2 + (y2 / 8) * SSD1306_WIDTH; i++) {
-      SSD1306_Buffer[i] ^= mask;
+    for (i = x1 + (y1 / 8) * dev->Width;
+         i <= (uint32_t)x2 + (y2 / 8) * dev->Width; i++) {
+      dev->Buffer[i] ^= mask;
     }
   }
   return SSD1306_OK;
@@ -556,10 +2347,12 @@ SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint
  *  
  */
 void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8_t w, uint8_t h, SSD1306_COLOR color) {
+    SSD1306_t *dev = ssd1306_Dev();
+
     int16_t byteWidth = (w + 7) / 8; 
     uint8_t byte = 0;
 
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+    if (x >= dev->ViewWidth || y >= dev->ViewHeight) {
         return;
     }
 
@@ -579,79 +2372,560 @@ void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8
     return;
 }
 
-void ssd1306_SetContrast(const uint8_t value) {
+/* Combina src com dst nos bits de mask, conforme o modo de ssd1306_BlitBitmap */
+static inline uint8_t ssd1306_BlitByte(uint8_t dst, uint8_t src, uint8_t mask, SSD1306_BlitMode_t mode) {
+    src &= mask;
+    switch (mode) {
+        case SSD1306_BLIT_OR:
+            return dst | src;
+        case SSD1306_BLIT_ANDNOT:
+            return dst & (uint8_t)~src;
+        case SSD1306_BLIT_XOR:
+            return dst ^ src;
+        default:
+            return (dst & (uint8_t)~mask) | src;
+    }
+}
+
+/**
+ * @brief Copia um bitmap página a página para o buffer, nas coordenadas do painel.
+ *
+ * Cada byte do bitmap cobre 8 linhas de uma coluna; quando y não é múltiplo
+ * de 8 ele é dividido entre duas páginas do buffer. Só os bits marcados na
+ * máscara (se houver) são alterados. O bitmap é recortado nas bordas do painel.
+ */
+static void ssd1306_BlitPage(SSD1306_t* dev, uint8_t x, uint8_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_BlitMode_t mode) {
+    const uint8_t shift = y % 8;
+    const uint8_t pages = (bitmap->height + 7) / 8;
+    const uint8_t w = (bitmap->width < dev->Width - x) ? bitmap->width : dev->Width - x;
+
+    for (uint8_t gp = 0; gp < pages && (y / 8 + gp) < dev->Pages; gp++) {
+        const uint8_t rows = ((bitmap->height - gp * 8) < 8) ? (bitmap->height - gp * 8) : 8;
+        const uint8_t valid = (uint8_t)(0xFF >> (8 - rows));
+        const uint8_t page = y / 8 + gp;
+        const uint8_t *src = &bitmap->data[gp * bitmap->width];
+        const uint8_t *msk = bitmap->mask ? &bitmap->mask[gp * bitmap->width] : NULL;
+        uint8_t *dst_lo = &dev->Buffer[page * dev->Width + x];
+        uint8_t *dst_hi = (shift && (page + 1) < dev->Pages) ? dst_lo + dev->Width : NULL;
+
+        for (uint8_t c = 0; c < w; c++) {
+            const uint8_t m = msk ? (msk[c] & valid) : valid;
+            dst_lo[c] = ssd1306_BlitByte(dst_lo[c], (uint8_t)(src[c] << shift), (uint8_t)(m << shift), mode);
+            if (dst_hi) {
+                dst_hi[c] = ssd1306_BlitByte(dst_hi[c], src[c] >> (8 - shift), m >> (8 - shift), mode);
+            }
+        }
+    }
+    const uint16_t y_end = y + bitmap->height - 1;
+    ssd1306_DirtyRect(dev, x, y, x + w - 1, (y_end < dev->Height) ? y_end : dev->Height - 1);
+}
+
+/**
+ * @brief Copia um bitmap página a página para o buffer transposto (retrato).
+ *
+ * Cada coluna do bitmap vira uma linha do painel, então um byte do bitmap não
+ * cai num byte do buffer: os bits são espalhados um a um pelas colunas do
+ * painel, uma linha do painel (um único bit de uma página) por vez.
+ */
+static void ssd1306_BlitTransposed(SSD1306_t* dev, uint8_t x, uint8_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_BlitMode_t mode) {
+    const uint8_t w = (bitmap->width < dev->ViewWidth - x) ? bitmap->width : dev->ViewWidth - x;
+    const uint8_t h = (bitmap->height < dev->ViewHeight - y) ? bitmap->height : dev->ViewHeight - y;
+
+    if (w == 0 || h == 0) {
+        return;
+    }
+    for (uint8_t c = 0; c < w; c++) {
+        const uint8_t bit = 1 << ((x + c) % 8);
+        uint8_t *dst = &dev->Buffer[((x + c) / 8) * dev->Width + y];
+
+        for (uint8_t r = 0; r < h; r++) {
+            const uint16_t k = (r / 8) * bitmap->width + c;
+            const uint8_t on = (bitmap->data[k] >> (r % 8)) & 1;
+            const uint8_t m = bitmap->mask ? (bitmap->mask[k] >> (r % 8)) & 1 : 1;
+            dst[r] = ssd1306_BlitByte(dst[r], on ? bit : 0, m ? bit : 0, mode);
+        }
+    }
+    ssd1306_DirtyRect(dev, y, x, y + h - 1, x + w - 1);
+}
+
+/**
+ * @brief Desenha um bitmap página a página (SSD1306_Bitmap_t) escrevendo bytes inteiros.
+ *
+ * Só os bits marcados na máscara (se houver) são alterados. O bitmap é
+ * recortado nas bordas da tela. Em retrato o bitmap é transposto pelo próprio
+ * blit (ssd1306_BlitTransposed).
+ */
+void ssd1306_BlitBitmap(uint8_t x, uint8_t y, const SSD1306_Bitmap_t* bitmap, SSD1306_BlitMode_t mode) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (bitmap == NULL || x >= dev->ViewWidth || y >= dev->ViewHeight) {
+        return;
+    }
+    if (dev->Transposed) {
+        ssd1306_BlitTransposed(dev, x, y, bitmap, mode);
+    } else {
+        ssd1306_BlitPage(dev, x, y, bitmap, mode);
+    }
+}
+
+/**
+ * @brief Liga o scroll horizontal contínuo por hardware nas páginas start_page..end_page.
+ *
+ * O buffer é enviado antes, para que a GDDRAM tenha o conteúdo atual. Depois
+ * disso o próprio controlador gira essas páginas (a coluna que sai de um lado
+ * entra do outro) sem nenhum tráfego I2C, e o flush deixa de escrevê-las até
+ * ssd1306_ScrollStop. Como a GDDRAM não pode ser escrita com o scroll ligado,
+ * um flush com alterações fora dessas páginas desliga o scroll antes.
+ */
+void ssd1306_ScrollHorizontal(SSD1306_ScrollDir_t dir, uint8_t start_page, uint8_t end_page, SSD1306_ScrollSpeed_t speed) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (start_page > end_page || end_page >= dev->Pages) {
+        return;
+    }
+    ssd1306_ScrollStop();
+    ssd1306_UpdateScreen();
+
+    SSD1306_CmdStream_t cmd;
+    ssd1306_CmdBegin(&cmd);
+    ssd1306_CmdPush(&cmd, 0x26 + dir);
+    ssd1306_CmdPush(&cmd, 0x00);
+    ssd1306_CmdPush(&cmd, start_page);
+    ssd1306_CmdPush(&cmd, speed);
+    ssd1306_CmdPush(&cmd, end_page);
+    ssd1306_CmdPush(&cmd, 0x00);
+    ssd1306_CmdPush(&cmd, 0xFF);
+    ssd1306_CmdPush(&cmd, 0x2F);
+    ssd1306_CmdSend(&cmd);
+
+    dev->ScrollActive = 1;
+    dev->ScrollStart = start_page;
+    dev->ScrollEnd = end_page;
+}
+
+/**
+ * @brief Liga o scroll diagonal: horizontal nas páginas indicadas e vertical na tela inteira.
+ *
+ * A cada passo a imagem sobe vertical_offset linhas (1 até a altura do display - 1).
+ * Como em ssd1306_ScrollHorizontal, as páginas com scroll horizontal deixam
+ * de ser escritas pelo flush até ssd1306_ScrollStop.
+ */
+void ssd1306_ScrollDiagonal(SSD1306_ScrollDir_t dir, uint8_t start_page, uint8_t end_page, SSD1306_ScrollSpeed_t speed, uint8_t vertical_offset) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (start_page > end_page || end_page >= dev->Pages ||
+        vertical_offset == 0 || vertical_offset >= dev->Height) {
+        return;
+    }
+    ssd1306_ScrollStop();
+    ssd1306_UpdateScreen();
+
+    SSD1306_CmdStream_t cmd;
+    ssd1306_CmdBegin(&cmd);
+    ssd1306_CmdPush(&cmd, 0xA3);    // Área de scroll vertical: a tela inteira
+    ssd1306_CmdPush(&cmd, 0x00);
+    ssd1306_CmdPush(&cmd, dev->Height);
+    ssd1306_CmdPush(&cmd, 0x29 + dir);
+    ssd1306_CmdPush(&cmd, 0x00);
+    ssd1306_CmdPush(&cmd, start_page);
+    ssd1306_CmdPush(&cmd, speed);
+    ssd1306_CmdPush(&cmd, end_page);
+    ssd1306_CmdPush(&cmd, vertical_offset);
+    ssd1306_CmdPush(&cmd, 0x2F);
+    ssd1306_CmdSend(&cmd);
+
+    dev->ScrollActive = 1;
+    dev->ScrollStart = start_page;
+    dev->ScrollEnd = end_page;
+}
+
+/**
+ * @brief Desliga o scroll por hardware e marca as páginas roladas para reenvio.
+ *
+ * O scroll altera a GDDRAM, então o conteúdo delas precisa ser reescrito a
+ * partir do buffer no próximo flush.
+ */
+void ssd1306_ScrollStop(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (!dev->ScrollActive) {
+        return;
+    }
+
+    SSD1306_CmdStream_t cmd;
+    ssd1306_CmdBegin(&cmd);
+    ssd1306_CmdPush(&cmd, 0x2E);
+    ssd1306_CmdPush(&cmd, 0x40);    // Desfaz o deslocamento do scroll diagonal
+    ssd1306_CmdSend(&cmd);
+
+    dev->ScrollActive = 0;
+    for (uint8_t page = dev->ScrollStart; page <= dev->ScrollEnd; page++) {
+        dev->ShownValid &= ~(1UL << page);
+    }
+    ssd1306_DirtyRect(dev, 0, dev->ScrollStart * 8, dev->Width - 1, dev->ScrollEnd * 8 + 7);
+}
+
+/**
+ * @brief Redesenha a faixa do letreiro no buffer, com o texto deslocado offset pixels para a esquerda.
+ *  
+ */
+static void ssd1306_MarqueeRender(SSD1306_t* dev) {
+    SSD1306_Marquee_t *m = &dev->Marquee;
+    const SSD1306_Font_t *font = m->font;
+    const uint8_t y_end = ((m->y + font->height - 1) | 7);
+    int16_t x = -(int16_t)m->offset;
+
+    ssd1306_FillSpan(dev, 0, dev->ViewWidth - 1, m->y, y_end, (SSD1306_COLOR)!m->color);
+
+    // Texto e, se ele já estiver saindo da tela, o recomeço dele depois do espaço.
+    // m->text só tem caracteres 32..126 (ssd1306_Marquee troca os outros por '?').
+    for (uint8_t copy = 0; copy < 2 && x < dev->ViewWidth; copy++) {
+        for (const char *p = m->text; *p && x < dev->ViewWidth; p++) {
+            const uint8_t advance = font->char_width ? font->char_width[(uint8_t)*p - 32] : font->width;
+            if (x + font->width > 0) {
+                ssd1306_DrawGlyph(dev, *p, font, x, m->y, m->color);
+            }
+            x += advance;
+        }
+        x += SSD1306_MARQUEE_GAP;
+        if (!m->software) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Mostra um letreiro rolando para a esquerda a partir da página page.
+ *
+ * Se o texto couber nos 128 pixels da tela ele é desenhado uma vez e rolado
+ * pelo scroll por hardware das páginas que ocupa, sem nenhum tráfego I2C por
+ * frame. A GDDRAM só tem 128 colunas, então um texto mais largo não cabe no
+ * giro do hardware: nesse caso (e em retrato) ele é rolado por software, um
+ * pixel a cada ssd1306_MarqueeTick, e só as páginas da faixa são reenviadas
+ * pelo flush. O scroll por hardware também dura só enquanto o resto da tela
+ * não muda: o primeiro flush que escrever fora da faixa o desliga e o
+ * letreiro passa a rolar por software.
+ * As páginas da faixa ficam inteiras com o letreiro. Cada display tem o seu.
+ */
+SSD1306_Error_t ssd1306_Marquee(const char* str, const SSD1306_Font_t* Font, uint8_t page, SSD1306_COLOR color, SSD1306_ScrollSpeed_t speed) {
+    SSD1306_t *dev = ssd1306_Dev();
+    SSD1306_Marquee_t *m = &dev->Marquee;
+
+    if (str == NULL || Font == NULL || page * 8 + Font->height > dev->ViewHeight) {
+        return SSD1306_ERR;
+    }
+    ssd1306_MarqueeStop();
+
+    m->width = 0;
+    uint8_t len = 0;
+    for (; str[len] && len < SSD1306_MARQUEE_MAX; len++) {
+        const char ch = (str[len] >= 32 && str[len] <= 126) ? str[len] : '?';
+        m->text[len] = ch;
+        m->width += Font->char_width ? Font->char_width[(uint8_t)ch - 32] : Font->width;
+    }
+    m->text[len] = '\0';
+    m->font = Font;
+    m->y = page * 8;
+    m->color = color;
+    m->offset = 0;
+    // Em retrato o scroll do controlador andaria na vertical da tela
+    m->software = (m->width > dev->ViewWidth) || dev->Transposed;
+    m->active = 1;
+
+    ssd1306_MarqueeRender(dev);
+    if (!m->software) {
+        // A 180 graus as colunas estão espelhadas: o giro para a direita aparece para a esquerda
+        const SSD1306_ScrollDir_t dir = (dev->Rotation == SSD1306_ROTATE_180) ? SSD1306_SCROLL_RIGHT : SSD1306_SCROLL_LEFT;
+        ssd1306_ScrollHorizontal(dir, page, (m->y + Font->height - 1) / 8, speed);
+    }
+    return SSD1306_OK;
+}
+
+/**
+ * @brief Avança o letreiro de ssd1306_Marquee um pixel (só quando ele é rolado por software).
+ *
+ * Deve ser chamada a cada frame, depois de desenhar o resto da tela e antes do flush.
+ */
+void ssd1306_MarqueeTick(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+    SSD1306_Marquee_t *m = &dev->Marquee;
+
+    if (!m->active || !m->software) {
+        return;
+    }
+    m->offset = (m->offset + 1) % (m->width + SSD1306_MARQUEE_GAP);
+    ssd1306_MarqueeRender(dev);
+}
+
+/**
+ * @brief Passa o letreiro do scroll por hardware para o por software.
+ *
+ * Chamada pelo flush quando precisa desligar o scroll para escrever o resto da
+ * tela: a faixa é redesenhada no buffer e volta a ser enviada a cada
+ * ssd1306_MarqueeTick.
+ */
+static void ssd1306_MarqueeToSoftware(SSD1306_t* dev) {
+    SSD1306_Marquee_t *m = &dev->Marquee;
+
+    if (!m->active || m->software) {
+        return;
+    }
+    m->software = 1;
+    m->offset = 0;
+    ssd1306_MarqueeRender(dev);
+}
+
+/**
+ * @brief Devolve ao buffer a faixa do letreiro que o scroll por hardware está girando.
+ *
+ * Com o scroll ligado o flush não escreve a faixa, então o que foi desenhado
+ * por cima dela (um ssd1306_Fill da tela inteira, por exemplo) só ficaria no
+ * buffer, e ssd1306_ReadRow mostraria a faixa apagada. O texto volta na
+ * posição inicial, que é o conteúdo que o controlador está girando.
+ */
+static void ssd1306_MarqueeRestore(SSD1306_t* dev) {
+    SSD1306_Marquee_t *m = &dev->Marquee;
+
+    if (m->active && !m->software) {
+        ssd1306_MarqueeRender(dev);
+    }
+}
+
+/**
+ * @brief Para o letreiro de ssd1306_Marquee.
+ *  
+ */
+void ssd1306_MarqueeStop(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+    SSD1306_Marquee_t *m = &dev->Marquee;
+
+    if (m->active && !m->software) {
+        ssd1306_ScrollStop();
+    }
+    m->active = 0;
+}
+
+#if SSD1306_OVERLAY_PAGES > 0
+/**
+ * @brief Liga ou desliga a sobreposição; as páginas dela são reenviadas no próximo flush.
+ *  
+ */
+void ssd1306_OverlayEnable(bool on) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (dev->OverlayOn != on) {
+        dev->OverlayOn = on;
+        dev->OverlayChanged = true;
+    }
+}
+
+/**
+ * @brief Apaga a sobreposição nas colunas x1..x2 (a tela de baixo volta a aparecer).
+ *  
+ */
+void ssd1306_OverlayClear(uint8_t x1, uint8_t x2) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (x1 >= dev->Width || x1 > x2) {
+        return;
+    }
+    if (x2 >= dev->Width) {
+        x2 = dev->Width - 1;
+    }
+    for (uint8_t page = 0; page < SSD1306_OVERLAY_PAGES; page++) {
+        memset(&dev->OverlayPixels[page * dev->Width + x1], 0, x2 - x1 + 1);
+        memset(&dev->OverlayMask[page * dev->Width + x1], 0, x2 - x1 + 1);
+    }
+    dev->OverlayChanged = true;
+}
+
+/**
+ * @brief Copia um bitmap para a sobreposição, alinhado à página indicada.
+ *
+ * Os bits da máscara do bitmap (ou o retângulo inteiro, sem máscara) passam a
+ * cobrir a tela com os pixels do bitmap. O que sai da faixa da sobreposição é
+ * descartado. Pode ser chamada pelo outro núcleo: o buffer da tela não é tocado
+ * e o envio acontece no próximo flush.
+ */
+void ssd1306_OverlayBlit(uint8_t x, uint8_t page, const SSD1306_Bitmap_t* bitmap) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    const uint8_t pages = (bitmap->height + 7) / 8;
+
+    for (uint8_t bp = 0; bp < pages && page + bp < SSD1306_OVERLAY_PAGES; bp++) {
+        const uint8_t rows = ((bitmap->height - bp * 8) < 8) ? (bitmap->height - bp * 8) : 8;
+        const uint8_t valid = (uint8_t)(0xFF >> (8 - rows));
+        for (uint8_t c = 0; c < bitmap->width && x + c < dev->Width; c++) {
+            const uint16_t src = bp * bitmap->width + c;
+            const uint16_t dst = (page + bp) * dev->Width + x + c;
+            const uint8_t mask = (bitmap->mask ? bitmap->mask[src] : 0xFF) & valid;
+            dev->OverlayPixels[dst] = (dev->OverlayPixels[dst] & ~mask) | (bitmap->data[src] & mask);
+            dev->OverlayMask[dst] |= mask;
+        }
+    }
+    dev->OverlayChanged = true;
+}
+
+/**
+ * @brief Envia a sobreposição alterada quando a tela ativa não tem nada a enviar.
+ *
+ * Para telas paradas (menus) que só fazem flush quando o usuário mexe: chamada
+ * nos laços de espera, manda só as páginas da sobreposição, sem redesenhar a tela.
+ */
+void ssd1306_OverlayFlush(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    if (dev->OverlayChanged && !ssd1306_FlushBusy()) {
+        ssd1306_UpdateScreenAsync();
+    }
+}
+#endif
+
+/* Envia o contraste ao display sem mudar o valor guardado no contexto */
+static void ssd1306_WriteContrast(uint8_t value) {
     const uint8_t kSetContrastControlRegister = 0x81;
-    ssd1306_WriteCommand(kSetContrastControlRegister);
-    ssd1306_WriteCommand(value);
+    SSD1306_CmdStream_t cmd;
+    ssd1306_CmdBegin(&cmd);
+    ssd1306_CmdPush(&cmd, kSetContrastControlRegister);
+    ssd1306_CmdPush(&cmd, value);
+    ssd1306_CmdSend(&cmd);
+}
+
+/**
+ * @brief Define o contraste do display.
+ *
+ * Com o display escurecido ou dormindo o valor só é guardado e vale ao acordar.
+ */
+void ssd1306_SetContrast(const uint8_t value) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    dev->Contrast = value;
+    if (dev->Idle.state == SSD1306_IDLE_ACTIVE) {
+        ssd1306_WriteContrast(value);
+    }
 }
 
 void ssd1306_SetDisplayOn(const uint8_t on) {
+    SSD1306_t *dev = ssd1306_Dev();
+
     uint8_t value;
     if (on) {
         value = 0xAF;   // Display on
-        SSD1306.DisplayOn = 1;
+        dev->DisplayOn = 1;
     } else {
         value = 0xAE;   // Display off
-        SSD1306.DisplayOn = 0;
+        dev->DisplayOn = 0;
     }
-    ssd1306_WriteCommand(value);
+    SSD1306_CmdStream_t cmd;
+    ssd1306_CmdBegin(&cmd);
+    ssd1306_CmdPush(&cmd, value);
+    ssd1306_CmdSend(&cmd);
 }
 
 uint8_t ssd1306_GetDisplayOn() {
-    return SSD1306.DisplayOn;
+    SSD1306_t *dev = ssd1306_Dev();
+
+    return dev->DisplayOn;
 }
 
+/**
+ * @brief Define a inatividade (ms) até escurecer e até desligar o display; 0 desliga a etapa.
+ *
+ * A contagem recomeça a partir de agora.
+ */
+void ssd1306_IdleConfig(uint32_t dim_ms, uint32_t off_ms) {
+    SSD1306_t *dev = ssd1306_Dev();
 
-static inline void swap_int16(int16_t *a, int16_t *b) {
-    int16_t temp = *a;
-    *a = *b;
-    *b = temp;
+    dev->Idle.dim_ms = dim_ms;
+    dev->Idle.off_ms = off_ms;
+    ssd1306_IdleKick();
 }
 
-void drawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, SSD1306_COLOR color) {
-    if (y0 > y1) {
-        swap_int16(&x0, &x1);
-        swap_int16(&y0, &y1);
+/**
+ * @brief Registra atividade do usuário e acorda o display na hora.
+ *
+ * Restaura o contraste e, se o display dormia, liga o display e envia o que foi
+ * desenhado enquanto os flushes estavam suspensos. Deve ser chamada entre dois
+ * frames (nos laços de espera), não no meio de um desenho.
+ */
+void ssd1306_IdleKick(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    const SSD1306_IdleState_t state = dev->Idle.state;
+
+    dev->Idle.last_activity = ssd1306_Millis();
+    if (state == SSD1306_IDLE_ACTIVE) {
+        return;
     }
-    if (y1 > y2) {
-        swap_int16(&x1, &x2);
-        swap_int16(&y1, &y2);
+
+    dev->Idle.state = SSD1306_IDLE_ACTIVE;
+    dev->Idle.step = 0;
+    ssd1306_WriteContrast(dev->Contrast);
+    if (state == SSD1306_IDLE_ASLEEP) {
+        ssd1306_UpdateScreenAsync();
+        ssd1306_SetDisplayOn(1);
     }
-    if (y0 > y1) {
-        swap_int16(&x0, &x1);
-        swap_int16(&y0, &y1);
+}
+
+/**
+ * @brief Avança o gerenciador de inatividade; chamada periodicamente nos laços de espera.
+ *
+ * Depois de dim_ms sem atividade o contraste desce em SSD1306_IDLE_RAMP_STEPS
+ * degraus até SSD1306_IDLE_DIM_CONTRAST, ao longo de SSD1306_IDLE_RAMP_MS (um
+ * comando por degrau). Depois de off_ms o display é desligado e os flushes
+ * ficam suspensos, então não há mais tráfego no barramento.
+ */
+void ssd1306_IdleTick(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    SSD1306_Idle_t *idle = &dev->Idle;
+
+    if (idle->state == SSD1306_IDLE_ASLEEP) {
+        return;
     }
-    int16_t dx01 = x1 - x0, dy01 = y1 - y0;
-    int16_t dx02 = x2 - x0, dy02 = y2 - y0;
-    int16_t dx12 = x2 - x1, dy12 = y2 - y1;
-    float invSlope01 = (dy01 != 0) ? (float)dx01 / dy01 : 0;
-    float invSlope02 = (dy02 != 0) ? (float)dx02 / dy02 : 0;
-    float invSlope12 = (dy12 != 0) ? (float)dx12 / dy12 : 0;
-    float curx1 = x0, curx2 = x0;
-    for (int y = y0; y <= y1; y++) {
-        int startx = (int)curx1;
-        int endx   = (int)curx2;
-        if (startx > endx) { int tmp = startx; startx = endx; endx = tmp; }
-        for (int x = startx; x <= endx; x++) {
-            ssd1306_DrawPixel((uint8_t)x, (uint8_t)y, color);
-        }
-        curx1 += invSlope01;
-        curx2 += invSlope02;
+
+    const uint32_t elapsed = ssd1306_Millis() - idle->last_activity;
+
+    if (idle->off_ms && elapsed >= idle->off_ms) {
+        idle->state = SSD1306_IDLE_ASLEEP;
+        ssd1306_SetDisplayOn(0);
+        return;
     }
-    curx1 = x1;
-    curx2 = x0 + invSlope02 * (y1 - y0);
-    for (int y = y1; y <= y2; y++) {
-        int startx = (int)curx1;
-        int endx   = (int)curx2;
-        if (startx > endx) { int tmp = startx; startx = endx; endx = tmp; }
-        for (int x = startx; x <= endx; x++) {
-            ssd1306_DrawPixel((uint8_t)x, (uint8_t)y, color);
+
+    if (idle->dim_ms && elapsed >= idle->dim_ms) {
+        const uint32_t ramp = elapsed - idle->dim_ms;
+        const uint8_t step = (ramp >= SSD1306_IDLE_RAMP_MS) ? SSD1306_IDLE_RAMP_STEPS
+                           : (uint8_t)(ramp * SSD1306_IDLE_RAMP_STEPS / SSD1306_IDLE_RAMP_MS);
+
+        idle->state = SSD1306_IDLE_DIMMING;
+        if (step != idle->step && dev->Contrast > SSD1306_IDLE_DIM_CONTRAST) {
+            const uint8_t drop = dev->Contrast - SSD1306_IDLE_DIM_CONTRAST;
+            idle->step = step;
+            ssd1306_WriteContrast(dev->Contrast - drop * step / SSD1306_IDLE_RAMP_STEPS);
         }
-        curx1 += invSlope12;
-        curx2 += invSlope02;
     }
 }
 
+/**
+ * @brief Estado atual do gerenciador de inatividade.
+ *  
+ */
+SSD1306_IdleState_t ssd1306_GetIdleState(void) {
+    SSD1306_t *dev = ssd1306_Dev();
+
+    return dev->Idle.state;
+}
+
+
+void drawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, SSD1306_COLOR color) {
+    const int16_t xs[3] = {x0, x1, x2};
+    const int16_t ys[3] = {y0, y1, y2};
+
+    ssd1306_FillPoly(xs, ys, 3, color);
+}
+
+// Demos da placa (botão, sleep e menu): não existem no build do host
+#if !defined(SSD1306_USE_HOST)
 
 //Função de callback para a interrupção do botão
 void button_callback(uint gpio, uint32_t events) {
@@ -833,9 +3107,10 @@ void animation_display(void)
     int dy = 1;
     const int radius = 4;
     
-    // Controle de tempo
+    // Controle de tempo: 30 fps, a bola anda 1 pixel a cada passo de 30 ms
+    FRAME_Scheduler_t fs;
+    frame_Init(&fs, 30, 30000);
     uint32_t start_time = to_ms_since_boot(get_absolute_time());
-    uint32_t last_update = start_time;
 
     while (true) 
     {
@@ -852,8 +3127,10 @@ void animation_display(void)
             break;
         }
 
-        // Atualiza posição a cada 30ms
-        if((now - last_update) > 30) 
+        frame_Begin(&fs);
+
+        // Atualiza a posição em passos fixos, independente da taxa de frames
+        while (frame_Step(&fs)) 
         {
             x += dx;
             y += dy;
@@ -861,19 +3138,20 @@ void animation_display(void)
             // Colisão com bordas
             if((x - radius <= 0) || (x + radius >= SSD1306_WIDTH)) dx *= -1;
             if((y - radius <= 0) || (y + radius >= SSD1306_HEIGHT)) dy *= -1;
-
-            last_update = now;
         }
 
         // Desenha o frame
         ssd1306_Fill(White);
         ssd1306_DrawRectangle(0, 0, SSD1306_WIDTH-1, SSD1306_HEIGHT-1, Black);
         ssd1306_FillCircle(x, y, radius, Black);
-        ssd1306_UpdateScreen();
+        ssd1306_UpdateScreenAsync();
+
+        frame_End(&fs);
     }
+    frame_PrintStats(&fs, "animation");
     
     // Volta ao menu após 2 segundos ou botão pressionado
     display_home();
 }
 
-
+#endif
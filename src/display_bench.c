@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <string.h>
+#include "inc/display_bench.h"
+#include "inc/fonts.h"
+
+#if defined(SSD1306_USE_HOST)
+#include <time.h>
+
+// Relógio do host no lugar do time_us_64 do Pico SDK
+static uint64_t bench_now_us(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+#else
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+#define bench_now_us() time_us_64()
+#endif
+
+// Pontos pseudoaleatórios (fixos entre execuções) usados como parâmetros das operações
+#define BENCH_POINTS 256
+static SSD1306_VERTEX Bench_Points[BENCH_POINTS];
+
+// Bitmap de teste 32x24, nos dois formatos: linhas (DrawBitmap) e páginas (BlitBitmap)
+#define BENCH_BITMAP_W 32
+#define BENCH_BITMAP_H 24
+static uint8_t Bench_BitmapRows[BENCH_BITMAP_W / 8 * BENCH_BITMAP_H];
+static uint8_t Bench_BitmapPages[BENCH_BITMAP_W * BENCH_BITMAP_H / 8];
+static const SSD1306_Bitmap_t Bench_Bitmap = { BENCH_BITMAP_W, BENCH_BITMAP_H, Bench_BitmapPages, NULL };
+
+// Fonte usada pelas operações de texto
+static const SSD1306_Font_t *Bench_Font;
+
+// Texto em RAM: nunca entra no cache de textos, mede a rasterização
+static char Bench_Text[] = "PicoEdu 0123";
+
+/* Operação medida: desenha a i-ésima variação e retorna os pixels nominais dela */
+typedef uint32_t (*bench_op_t)(uint32_t i);
+
+static inline const SSD1306_VERTEX* bench_point(uint32_t i) {
+    return &Bench_Points[i & (BENCH_POINTS - 1)];
+}
+
+static inline uint8_t bench_abs_diff(uint8_t a, uint8_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+static uint32_t bench_pixel(uint32_t i) {
+    const SSD1306_VERTEX *p = bench_point(i);
+    ssd1306_DrawPixel(p->x, p->y, (i & 1) ? White : Black);
+    return 1;
+}
+
+static uint32_t bench_line(uint32_t i) {
+    const SSD1306_VERTEX *a = bench_point(i), *b = bench_point(i + 1);
+    const uint8_t dx = bench_abs_diff(a->x, b->x), dy = bench_abs_diff(a->y, b->y);
+    ssd1306_Line(a->x, a->y, b->x, b->y, (i & 1) ? White : Black);
+    return ((dx > dy) ? dx : dy) + 1;
+}
+
+static uint32_t bench_rectangle(uint32_t i) {
+    const SSD1306_VERTEX *a = bench_point(i), *b = bench_point(i + 1);
+    const uint32_t w = bench_abs_diff(a->x, b->x) + 1, h = bench_abs_diff(a->y, b->y) + 1;
+    ssd1306_DrawRectangle(a->x, a->y, b->x, b->y, (i & 1) ? White : Black);
+    return (w > 1 && h > 1) ? 2 * (w + h) - 4 : w * h;
+}
+
+static uint32_t bench_fill_rectangle(uint32_t i) {
+    const SSD1306_VERTEX *a = bench_point(i), *b = bench_point(i + 1);
+    const uint32_t w = bench_abs_diff(a->x, b->x) + 1, h = bench_abs_diff(a->y, b->y) + 1;
+    ssd1306_FillRectangle(a->x, a->y, b->x, b->y, (i & 1) ? White : Black);
+    return w * h;
+}
+
+static uint32_t bench_circle(uint32_t i) {
+    const SSD1306_VERTEX *p = bench_point(i);
+    const uint8_t r = 4 + (i % 28);
+    ssd1306_DrawCircle(p->x, p->y, r, (i & 1) ? White : Black);
+    return (44 * r) / 7;    // 2*pi*r
+}
+
+static uint32_t bench_arc(uint32_t i) {
+    const SSD1306_VERTEX *p = bench_point(i);
+    const uint8_t r = 4 + (i % 28);
+    const uint16_t sweep = 45 + (i % 8) * 45;
+    ssd1306_DrawArc(p->x, p->y, r, (i * 37) % 360, sweep, (i & 1) ? White : Black);
+    return (44 * r * sweep) / (7 * 360);
+}
+
+static uint32_t bench_triangle(uint32_t i) {
+    const SSD1306_VERTEX *a = bench_point(i), *b = bench_point(i + 1), *c = bench_point(i + 2);
+    const int32_t area2 = (int32_t)(b->x - a->x) * (c->y - a->y) - (int32_t)(c->x - a->x) * (b->y - a->y);
+    drawFilledTriangle(a->x, a->y, b->x, b->y, c->x, c->y, (i & 1) ? White : Black);
+    return ((area2 < 0) ? -area2 : area2) / 2 + 1;
+}
+
+static uint32_t bench_bitmap(uint32_t i) {
+    const SSD1306_VERTEX *p = bench_point(i);
+    ssd1306_DrawBitmap(p->x, p->y, Bench_BitmapRows, BENCH_BITMAP_W, BENCH_BITMAP_H, (i & 1) ? White : Black);
+    return BENCH_BITMAP_W * BENCH_BITMAP_H;
+}
+
+static uint32_t bench_blit(uint32_t i) {
+    const SSD1306_VERTEX *p = bench_point(i);
+    ssd1306_BlitBitmap(p->x, p->y, &Bench_Bitmap, (i & 1) ? SSD1306_BLIT_COPY : SSD1306_BLIT_XOR);
+    return BENCH_BITMAP_W * BENCH_BITMAP_H;
+}
+
+/* Pixels das células dos glifos escritos */
+static uint32_t bench_text_pixels(const char *str) {
+    uint32_t pixels = 0;
+    for (; *str; str++) {
+        pixels += (Bench_Font->char_width ? Bench_Font->char_width[*str - 32] : Bench_Font->width) * Bench_Font->height;
+    }
+    return pixels;
+}
+
+static uint32_t bench_write_string(uint32_t i) {
+    const SSD1306_VERTEX *p = bench_point(i);
+    ssd1306_SetCursor(p->x & 63, p->y & 31);
+    ssd1306_WriteString(Bench_Text, *Bench_Font, (i & 1) ? White : Black);
+    return bench_text_pixels(Bench_Text);
+}
+
+#if SSD1306_TEXT_CACHE_BYTES > 0 && !defined(SSD1306_USE_HOST)
+// Texto constante (flash): a partir da segunda escrita vem do cache de textos
+static uint32_t bench_write_cached(uint32_t i) {
+    static const char text[] = "PicoEdu 0123";
+    const SSD1306_VERTEX *p = bench_point(i);
+    ssd1306_SetCursor(p->x & 63, p->y & 31);
+    ssd1306_WriteString((char*)text, *Bench_Font, (i & 1) ? White : Black);
+    return bench_text_pixels(text);
+}
+#endif
+
+/**
+ * @brief Gera os pontos e os bitmaps de teste (sempre os mesmos).
+ *
+ */
+static void bench_setup(void) {
+    uint32_t seed = 0x2545F491u;
+
+    for (uint32_t i = 0; i < BENCH_POINTS; i++) {
+        // xorshift32
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        Bench_Points[i].x = seed % SSD1306_WIDTH;
+        Bench_Points[i].y = (seed >> 8) % SSD1306_HEIGHT;
+    }
+
+    // Tabuleiro de 4x4 pixels dentro de uma moldura
+    memset(Bench_BitmapRows, 0, sizeof(Bench_BitmapRows));
+    memset(Bench_BitmapPages, 0, sizeof(Bench_BitmapPages));
+    for (uint8_t y = 0; y < BENCH_BITMAP_H; y++) {
+        for (uint8_t x = 0; x < BENCH_BITMAP_W; x++) {
+            const bool border = x == 0 || y == 0 || x == BENCH_BITMAP_W - 1 || y == BENCH_BITMAP_H - 1;
+            if (border || (((x >> 2) ^ (y >> 2)) & 1)) {
+                Bench_BitmapRows[y * (BENCH_BITMAP_W / 8) + x / 8] |= 0x80 >> (x & 7);
+                Bench_BitmapPages[(y / 8) * BENCH_BITMAP_W + x] |= 1 << (y & 7);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Mede uma primitiva e imprime a linha dela na tabela.
+ *
+ * A tela começa apagada e já enviada; as operações são repetidas em lotes de
+ * SSD1306_BENCH_BATCH até somar SSD1306_BENCH_MIN_US, e depois o resultado é
+ * enviado com ssd1306_UpdateScreen para medir o flush.
+ */
+static void bench_run(const char *name, const char *font, bench_op_t op) {
+    uint64_t elapsed = 0, pixels = 0;
+    uint32_t ops = 0;
+
+    ssd1306_Fill(Black);
+    ssd1306_UpdateScreen();
+
+    while (elapsed < SSD1306_BENCH_MIN_US) {
+        const uint64_t start = bench_now_us();
+        for (uint32_t k = 0; k < SSD1306_BENCH_BATCH; k++, ops++) {
+            pixels += op(ops);
+        }
+        elapsed += bench_now_us() - start;
+    }
+
+    const uint64_t flush_start = bench_now_us();
+    ssd1306_UpdateScreen();
+    const uint64_t flush_us = bench_now_us() - flush_start;
+
+#if defined(SSD1306_USE_HOST)
+    const uint64_t cycles = 0;
+#else
+    const uint64_t cycles = elapsed * (clock_get_hz(clk_sys) / 1000000u) / ops;
+#endif
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+
+    printf("%s,%s,%lu,%llu,%llu,%llu,%llu,%llu,%lu,%llu\n", name, font, (unsigned long)ops,
+           (unsigned long long)elapsed,
+           (unsigned long long)(elapsed * 1000u / ops),
+           (unsigned long long)cycles,
+           (unsigned long long)((uint64_t)ops * 1000000u / elapsed),
+           (unsigned long long)(pixels * 1000000u / elapsed),
+           (unsigned long)ssd1306_GetFlushStats()->last_sent,
+           (unsigned long long)flush_us);
+}
+
+/**
+ * @brief Mede o flush de uma tela inteira (sync e, na placa, por DMA).
+ *
+ */
+static void bench_flush(void) {
+    const uint32_t frames = 16;
+    uint64_t elapsed = 0;
+
+    for (uint32_t k = 0; k < frames; k++) {
+        ssd1306_Fill((k & 1) ? White : Black);
+        const uint64_t start = bench_now_us();
+        ssd1306_UpdateScreen();
+        elapsed += bench_now_us() - start;
+    }
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+    printf("UpdateScreen,-,%lu,%llu,%llu,0,%llu,%llu,%lu,%llu\n", (unsigned long)frames,
+           (unsigned long long)elapsed,
+           (unsigned long long)(elapsed * 1000u / frames),
+           (unsigned long long)((uint64_t)frames * 1000000u / elapsed),
+           (unsigned long long)((uint64_t)frames * SSD1306_WIDTH * SSD1306_HEIGHT * 1000000u / elapsed),
+           (unsigned long)ssd1306_GetFlushStats()->last_sent,
+           (unsigned long long)(elapsed / frames));
+}
+
+/**
+ * @brief Roda todas as medições e imprime a tabela CSV no stdio.
+ *
+ * O display é usado como área de trabalho: o conteúdo anterior é perdido.
+ */
+void ssd1306_Benchmark(void) {
+    static const struct {
+        const char *name;
+        const SSD1306_Font_t *font;
+    } fonts[] = {
+#ifdef SSD1306_INCLUDE_FONT_6x8
+        { "6x8", &Font_6x8 },
+#endif
+#ifdef SSD1306_INCLUDE_FONT_7x10
+        { "7x10", &Font_7x10 },
+#endif
+#ifdef SSD1306_INCLUDE_FONT_11x18
+        { "11x18", &Font_11x18 },
+#endif
+#ifdef SSD1306_INCLUDE_FONT_16x26
+        { "16x26", &Font_16x26 },
+#endif
+#ifdef SSD1306_INCLUDE_FONT_16x24
+        { "16x24", &Font_16x24 },
+#endif
+#ifdef SSD1306_INCLUDE_FONT_16x15
+        { "16x15", &Font_16x15 },
+#endif
+    };
+
+    bench_setup();
+
+#if defined(SSD1306_USE_HOST)
+    printf("# ssd1306 bench: host, min %u us per primitive\n", (unsigned)SSD1306_BENCH_MIN_US);
+#else
+    printf("# ssd1306 bench: rp2040 clk_sys %lu Hz, i2c %u kHz, min %u us per primitive\n",
+           (unsigned long)clock_get_hz(clk_sys), (unsigned)SSD1306_I2C_CLK, (unsigned)SSD1306_BENCH_MIN_US);
+#endif
+    printf("primitive,font,ops,total_us,ns_per_op,cycles_per_op,ops_per_s,pixels_per_s,bytes_flushed,flush_us\n");
+
+    bench_run("DrawPixel", "-", bench_pixel);
+    bench_run("Line", "-", bench_line);
+    bench_run("DrawRectangle", "-", bench_rectangle);
+    bench_run("FillRectangle", "-", bench_fill_rectangle);
+    bench_run("DrawCircle", "-", bench_circle);
+    bench_run("DrawArc", "-", bench_arc);
+    bench_run("FilledTriangle", "-", bench_triangle);
+    bench_run("DrawBitmap", "-", bench_bitmap);
+    bench_run("BlitBitmap", "-", bench_blit);
+    for (uint8_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        Bench_Font = fonts[f].font;
+        bench_run("WriteString", fonts[f].name, bench_write_string);
+#if SSD1306_TEXT_CACHE_BYTES > 0 && !defined(SSD1306_USE_HOST)
+        bench_run("WriteStringCached", fonts[f].name, bench_write_cached);
+#endif
+    }
+    bench_flush();
+
+    ssd1306_Fill(Black);
+    ssd1306_UpdateScreen();
+}
@@ -0,0 +1,385 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/display_host.h"
+
+/* Display emulado: controlador e estado da transação I2C em andamento */
+typedef struct {
+    bool used;
+    uint8_t bus;                 // Índice do barramento (i2c0 = 0, i2c1 = 1)
+    uint8_t address;
+    SSD1306_HostState_t state;
+    bool expect_control;         // Próximo byte é um byte de controle
+    bool continuation;           // Co = 0: o resto da transação é do mesmo tipo
+    bool data;                   // D/C# do último byte de controle
+    uint8_t cmd[8];              // Comando em andamento e seus argumentos
+    uint8_t cmd_len;
+    uint8_t cmd_need;
+} SSD1306_HostPanel_t;
+
+i2c_inst_t ssd1306_host_i2c[2] = { { 0 }, { 1 } };
+
+static SSD1306_HostPanel_t SSD1306_HostPanels[SSD1306_HOST_DISPLAYS];
+
+// Display que recebe os bytes e que as funções de inspeção leem
+static SSD1306_HostPanel_t *SSD1306_HostCurrent = &SSD1306_HostPanels[0];
+
+/**
+ * @brief Escolhe o display emulado ligado ao barramento e endereço indicados.
+ *
+ * O primeiro acesso a um par barramento + endereço ocupa um display novo. As
+ * transações seguintes e as funções de inspeção (estado, pixels, imagens) passam
+ * a usar esse display; com todos ocupados fica o último.
+ */
+void ssd1306_HostSelect(const i2c_inst_t* bus, uint8_t address) {
+    SSD1306_HostPanel_t *free_panel = NULL;
+
+    for (uint8_t i = 0; i < SSD1306_HOST_DISPLAYS; i++) {
+        SSD1306_HostPanel_t *panel = &SSD1306_HostPanels[i];
+        if (panel->used && panel->bus == bus->index && panel->address == address) {
+            SSD1306_HostCurrent = panel;
+            return;
+        }
+        if (!panel->used && free_panel == NULL) {
+            free_panel = panel;
+        }
+    }
+    if (free_panel == NULL) {
+        free_panel = &SSD1306_HostPanels[SSD1306_HOST_DISPLAYS - 1];
+    }
+    free_panel->used = true;
+    free_panel->bus = bus->index;
+    free_panel->address = address;
+    SSD1306_HostCurrent = free_panel;
+    ssd1306_HostReset();
+}
+
+/**
+ * @brief Volta o controlador emulado ao estado de power-on do datasheet.
+ *
+ */
+void ssd1306_HostReset(void) {
+    SSD1306_HostPanel_t *p = SSD1306_HostCurrent;
+
+    memset(&p->state, 0, sizeof(p->state));
+    p->state.addressing = 2;
+    p->state.column_end = SSD1306_HOST_COLUMNS - 1;
+    p->state.page_end = SSD1306_HOST_PAGES - 1;
+    p->state.multiplex = 63;
+    p->state.contrast = 0x7F;
+    p->expect_control = true;
+    p->cmd_need = 0;
+}
+
+/* Quantidade de argumentos de cada comando (os demais não têm argumentos) */
+static uint8_t ssd1306_HostArgs(uint8_t cmd) {
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Executa um comando completo (com argumentos) no controlador emulado.
+ *
+ */
+static void ssd1306_HostExecute(const uint8_t* c) {
+    SSD1306_HostState_t *s = &SSD1306_HostCurrent->state;
+
+    if (c[0] <= 0x0F) {
+        s->column = (s->column & 0xF0) | c[0];
+    } else if (c[0] <= 0x1F) {
+        s->column = (s->column & 0x0F) | ((c[0] & 0x07) << 4);
+    } else if (c[0] >= 0x40 && c[0] <= 0x7F) {
+        s->start_line = c[0] & 0x3F;
+    } else if (c[0] >= 0xB0 && c[0] <= 0xB7) {
+        s->page = c[0] & 0x07;
+    } else {
+        switch (c[0]) {
+            case 0x20: s->addressing = c[1] & 0x03; break;
+            case 0x21:
+                s->column_start = s->column = c[1] & 0x7F;
+                s->column_end = c[2] & 0x7F;
+                break;
+            case 0x22:
+                s->page_start = s->page = c[1] & 0x07;
+                s->page_end = c[2] & 0x07;
+                break;
+            case 0x2E: s->scroll_active = false; break;
+            case 0x2F: s->scroll_active = true; break;
+            case 0x81: s->contrast = c[1]; break;
+            case 0xA0: s->segment_remap = false; break;
+            case 0xA1: s->segment_remap = true; break;
+            case 0xA4: s->entire_on = false; break;
+            case 0xA5: s->entire_on = true; break;
+            case 0xA6: s->inverted = false; break;
+            case 0xA7: s->inverted = true; break;
+            case 0xA8: s->multiplex = (c[1] & 0x3F) < 15 ? s->multiplex : (c[1] & 0x3F); break;
+            case 0xAE: s->display_on = false; break;
+            case 0xAF: s->display_on = true; break;
+            case 0xC0: s->com_reverse = false; break;
+            case 0xC8: s->com_reverse = true; break;
+            case 0xD3: s->display_offset = c[1] & 0x3F; break;
+            default: break;   // Timing, charge pump, scroll: sem efeito na imagem
+        }
+    }
+}
+
+/**
+ * @brief Escreve um byte de dados na GDDRAM e avança os ponteiros conforme o modo de endereçamento.
+ *
+ */
+static void ssd1306_HostData(uint8_t byte) {
+    SSD1306_HostState_t *s = &SSD1306_HostCurrent->state;
+
+    if (s->scroll_active) {
+        s->scroll_writes++;
+    }
+    s->gddram[s->page][s->column] = byte;
+    if (s->addressing == 0) {
+        if (s->column++ >= s->column_end) {
+            s->column = s->column_start;
+            s->page = (s->page >= s->page_end) ? s->page_start : s->page + 1;
+        }
+    } else if (s->addressing == 1) {
+        if (s->page++ >= s->page_end) {
+            s->page = s->page_start;
+            s->column = (s->column >= s->column_end) ? s->column_start : s->column + 1;
+        }
+    } else {
+        s->column = (s->column + 1) % SSD1306_HOST_COLUMNS;
+    }
+}
+
+/**
+ * @brief Condição de START seguida do endereço do display.
+ *
+ */
+void ssd1306_HostStart(void) {
+    SSD1306_HostCurrent->state.transactions++;
+    SSD1306_HostCurrent->expect_control = true;
+    SSD1306_HostCurrent->continuation = false;
+}
+
+/**
+ * @brief Recebe um byte da transação atual (controle, comando ou dado).
+ *
+ */
+void ssd1306_HostByte(uint8_t byte) {
+    SSD1306_HostPanel_t *p = SSD1306_HostCurrent;
+
+    p->state.bytes++;
+
+    if (p->expect_control) {
+        p->continuation = !(byte & 0x80);
+        p->data = (byte & 0x40) != 0;
+        p->expect_control = false;
+        return;
+    }
+
+    if (p->data) {
+        ssd1306_HostData(byte);
+    } else {
+        if (p->cmd_need == 0) {
+            p->cmd_len = 0;
+            p->cmd_need = ssd1306_HostArgs(byte) + 1;
+        }
+        p->cmd[p->cmd_len++] = byte;
+        if (--p->cmd_need == 0) {
+            ssd1306_HostExecute(p->cmd);
+        }
+    }
+
+    // Com Co = 1 cada byte vem precedido do próprio byte de controle
+    if (!p->continuation) {
+        p->expect_control = true;
+    }
+}
+
+/**
+ * @brief Condição de STOP: a próxima transação recomeça pelo byte de controle.
+ *
+ */
+void ssd1306_HostStop(void) {
+    SSD1306_HostCurrent->expect_control = true;
+}
+
+/**
+ * @brief Transação completa (START, bytes, STOP), como um i2c_write_blocking.
+ *
+ */
+void ssd1306_HostWrite(const uint8_t* bytes, size_t len) {
+    ssd1306_HostStart();
+    for (size_t i = 0; i < len; i++) {
+        ssd1306_HostByte(bytes[i]);
+    }
+    ssd1306_HostStop();
+}
+
+/**
+ * @brief Retorna o estado do controlador emulado (GDDRAM, ponteiros e registradores).
+ *
+ */
+const SSD1306_HostState_t* ssd1306_HostState(void) {
+    return &SSD1306_HostCurrent->state;
+}
+
+/**
+ * @brief Retorna se o pixel (x, y) do painel está aceso, como o usuário o veria.
+ *
+ * Aplica o remapeamento de segmentos e de COM (com A1 e C8, os valores do
+ * ssd1306_Init, a coluna 0 fica à esquerda e a linha 0 em cima), a linha
+ * inicial, o deslocamento vertical, a inversão e o display ligado/desligado.
+ */
+bool ssd1306_HostPixel(uint8_t x, uint8_t y) {
+    const SSD1306_HostState_t *s = &SSD1306_HostCurrent->state;
+
+    if (!s->display_on || x >= SSD1306_HOST_COLUMNS || y > s->multiplex) {
+        return false;
+    }
+    if (s->entire_on) {
+        return true;
+    }
+
+    const uint8_t line = s->com_reverse ? y : (uint8_t)(s->multiplex - y);
+    const uint8_t row = (line + s->start_line + s->display_offset) % (SSD1306_HOST_PAGES * 8);
+    const uint8_t col = s->segment_remap ? x : (uint8_t)(SSD1306_HOST_COLUMNS - 1 - x);
+    const bool on = (s->gddram[row / 8][col] >> (row % 8)) & 1;
+
+    return on != s->inverted;
+}
+
+/* Nível de cinza de um pixel aceso, conforme o contraste (0x81) */
+static uint8_t ssd1306_HostLit(void) {
+    return 64 + (191 * SSD1306_HostCurrent->state.contrast) / 255;
+}
+
+/**
+ * @brief Grava a imagem do painel num arquivo PGM binário, ampliada scale vezes.
+ *
+ * Pixels acesos ficam mais claros conforme o contraste (0x81). Retorna 0 em
+ * caso de sucesso e -1 se o arquivo não puder ser gravado.
+ */
+int ssd1306_HostDumpPGM(const char* path, uint8_t scale) {
+    const SSD1306_HostState_t *s = &SSD1306_HostCurrent->state;
+    const unsigned width = SSD1306_HOST_COLUMNS * (scale ? scale : 1);
+    const unsigned height = (s->multiplex + 1u) * (scale ? scale : 1);
+    const uint8_t lit = ssd1306_HostLit();
+    uint8_t row[SSD1306_HOST_COLUMNS * 255];
+    FILE *f = fopen(path, "wb");
+
+    if (f == NULL) {
+        return -1;
+    }
+    scale = scale ? scale : 1;
+    fprintf(f, "P5\n%u %u\n255\n", width, height);
+    for (unsigned y = 0; y <= s->multiplex; y++) {
+        for (unsigned x = 0; x < width; x++) {
+            row[x] = ssd1306_HostPixel(x / scale, y) ? lit : 0;
+        }
+        for (uint8_t k = 0; k < scale; k++) {
+            fwrite(row, 1, width, f);
+        }
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/* CRC-32 (PNG) calculado bit a bit: as imagens são pequenas */
+static uint32_t ssd1306_HostCrc(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void ssd1306_HostPut32(uint8_t* p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+/* Grava um chunk PNG (tamanho, tipo, dados e CRC) */
+static void ssd1306_HostChunk(FILE* f, const char* type, const uint8_t* data, uint32_t len) {
+    uint8_t head[8], tail[4];
+
+    ssd1306_HostPut32(head, len);
+    memcpy(head + 4, type, 4);
+    ssd1306_HostPut32(tail, ssd1306_HostCrc(ssd1306_HostCrc(0, head + 4, 4), data, len));
+    fwrite(head, 1, sizeof(head), f);
+    fwrite(data, 1, len, f);
+    fwrite(tail, 1, sizeof(tail), f);
+}
+
+/**
+ * @brief Grava a imagem do painel num PNG em tons de cinza, ampliada scale vezes.
+ *
+ * Sem depender da zlib: cada linha vai num bloco deflate sem compressão
+ * ("stored"). Retorna 0 em caso de sucesso e -1 se o arquivo não puder ser gravado.
+ */
+int ssd1306_HostDumpPNG(const char* path, uint8_t scale) {
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const SSD1306_HostState_t *s = &SSD1306_HostCurrent->state;
+    const uint8_t lit = ssd1306_HostLit();
+    scale = scale ? scale : 1;
+    const uint32_t width = SSD1306_HOST_COLUMNS * scale;
+    const uint32_t height = (s->multiplex + 1u) * scale;
+    const uint32_t line = width + 1;              // Filtro (0) + pixels
+    const uint32_t block = 5 + line;              // Cabeçalho do bloco stored + linha
+    const uint32_t idat_len = 2 + height * block + 4;
+    uint8_t ihdr[13] = { 0 };
+    uint8_t *idat = malloc(idat_len);
+    FILE *f;
+
+    if (idat == NULL) {
+        return -1;
+    }
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        free(idat);
+        return -1;
+    }
+
+    ssd1306_HostPut32(ihdr, width);
+    ssd1306_HostPut32(ihdr + 4, height);
+    ihdr[8] = 8;    // 8 bits por pixel, tons de cinza, sem entrelaçamento
+
+    uint8_t *p = idat;
+    uint32_t a = 1, b = 0;    // Adler-32 dos dados descomprimidos
+    *p++ = 0x78;
+    *p++ = 0x01;
+    for (uint32_t y = 0; y < height; y++) {
+        *p++ = (y + 1 == height) ? 1 : 0;     // BFINAL no último bloco, BTYPE = 00
+        *p++ = line & 0xFF;
+        *p++ = line >> 8;
+        *p++ = ~line & 0xFF;
+        *p++ = (~line >> 8) & 0xFF;
+        for (uint32_t x = 0; x < line; x++) {
+            const uint8_t v = (x == 0) ? 0 : (ssd1306_HostPixel((x - 1) / scale, y / scale) ? lit : 0);
+            *p++ = v;
+            a = (a + v) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    ssd1306_HostPut32(p, (b << 16) | a);
+
+    fwrite(signature, 1, sizeof(signature), f);
+    ssd1306_HostChunk(f, "IHDR", ihdr, sizeof(ihdr));
+    ssd1306_HostChunk(f, "IDAT", idat, idat_len);
+    ssd1306_HostChunk(f, "IEND", NULL, 0);
+    free(idat);
+    return fclose(f) == 0 ? 0 : -1;
+}
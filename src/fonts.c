@@ -1,3 +1,5 @@
+/* Tabelas de origem das fontes (uma linha de 16 bits por linha do glifo). Este arquivo
+ * não é compilado diretamente: tools/fontpack gera fonts_packed.c a partir dele. */
 
 #include "inc/fonts.h"
 
@@ -0,0 +1,149 @@
+#if defined(SSD1306_USE_HOST)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "inc/frame.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(SSD1306_USE_HOST)
+#include <time.h>
+
+// Relógio e espera do host no lugar dos do Pico SDK
+static uint64_t time_us_64(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static void sleep_us(uint64_t us) {
+    struct timespec ts = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    nanosleep(&ts, NULL);
+}
+#else
+#include "pico/stdlib.h"
+#endif
+
+/**
+ * @brief Prepara o agendador para fps frames por segundo e passos de step_us.
+ *
+ * O primeiro frame sai na hora; a simulação começa a contar a partir dele.
+ */
+void frame_Init(FRAME_Scheduler_t *fs, uint16_t fps, uint32_t step_us) {
+    memset(fs, 0, sizeof(*fs));
+    fs->frame_us = 1000000u / (fps ? fps : 1);
+    fs->step_us = step_us;
+    fs->min_us = UINT32_MAX;
+}
+
+/**
+ * @brief Espera o horário do próximo frame e acumula o tempo a simular.
+ *
+ */
+void frame_Begin(FRAME_Scheduler_t *fs) {
+    uint64_t now = time_us_64();
+
+    if (fs->frames == 0) {
+        fs->next_frame = now;
+    } else if (now < fs->next_frame) {
+        sleep_us(fs->next_frame - now);
+        now = time_us_64();
+    }
+
+    if (fs->last_begin) {
+        const uint64_t interval = now - fs->last_begin;
+        const uint32_t us = (interval > UINT32_MAX) ? UINT32_MAX : (uint32_t)interval;
+        const uint32_t bin = (us / 1000 < FRAME_HIST_MS) ? us / 1000 : FRAME_HIST_MS;
+
+        fs->accumulator += interval;
+        fs->min_us = (us < fs->min_us) ? us : fs->min_us;
+        fs->max_us = (us > fs->max_us) ? us : fs->max_us;
+        fs->sum_us += us;
+        fs->histogram[bin]++;
+        fs->intervals++;
+    }
+    if (fs->accumulator > (uint64_t)fs->step_us * FRAME_MAX_STEPS) {
+        fs->accumulator = (uint64_t)fs->step_us * FRAME_MAX_STEPS;
+    }
+
+    fs->last_begin = now;
+    fs->begin = now;
+}
+
+/**
+ * @brief Consome um passo fixo do tempo acumulado.
+ *
+ * Retorna true enquanto houver um passo inteiro a simular neste frame.
+ */
+bool frame_Step(FRAME_Scheduler_t *fs) {
+    if (fs->step_us == 0 || fs->accumulator < fs->step_us) {
+        return false;
+    }
+    fs->accumulator -= fs->step_us;
+    return true;
+}
+
+/**
+ * @brief Fecha o frame: mede o trabalho e agenda o próximo.
+ *
+ * Se o frame estourou o prazo, os horários que já passaram inteiros são pulados
+ * (descartados) e o próximo frame começa sem espera.
+ */
+void frame_End(FRAME_Scheduler_t *fs) {
+    const uint64_t now = time_us_64();
+
+    fs->busy_sum_us += now - fs->begin;
+    fs->frames++;
+
+    fs->next_frame += fs->frame_us;
+    if (now > fs->next_frame) {
+        const uint64_t missed = (now - fs->next_frame) / fs->frame_us;
+        fs->next_frame += missed * fs->frame_us;
+        fs->dropped += (uint32_t)missed;
+    }
+}
+
+/**
+ * @brief Resume os contadores do agendador (mínimo, média, p99 e descartes).
+ *
+ */
+void frame_GetStats(const FRAME_Scheduler_t *fs, FRAME_Stats_t *stats) {
+    stats->frames = fs->frames;
+    stats->dropped = fs->dropped;
+    stats->min_us = fs->intervals ? fs->min_us : 0;
+    stats->max_us = fs->max_us;
+    stats->avg_us = fs->intervals ? (uint32_t)(fs->sum_us / fs->intervals) : 0;
+    stats->busy_us = fs->frames ? (uint32_t)(fs->busy_sum_us / fs->frames) : 0;
+
+    // Fim da primeira faixa do histograma que alcança 99% dos intervalos
+    stats->p99_us = 0;
+    if (fs->intervals) {
+        const uint32_t target = fs->intervals - fs->intervals / 100;
+        uint32_t count = 0;
+        for (uint32_t bin = 0; bin <= FRAME_HIST_MS; bin++) {
+            count += fs->histogram[bin];
+            if (count >= target) {
+                stats->p99_us = (bin < FRAME_HIST_MS) ? (bin + 1) * 1000 : fs->max_us;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Imprime (stdio) as estatísticas dos frames da tela indicada.
+ *
+ */
+void frame_PrintStats(const FRAME_Scheduler_t *fs, const char *name) {
+#if FRAME_PRINT_STATS
+    FRAME_Stats_t stats;
+    frame_GetStats(fs, &stats);
+    printf("frame: %s %lu frames, %lu dropped, min %lu avg %lu p99 %lu max %lu us, busy %lu us\n", name,
+           (unsigned long)stats.frames, (unsigned long)stats.dropped, (unsigned long)stats.min_us,
+           (unsigned long)stats.avg_us, (unsigned long)stats.p99_us, (unsigned long)stats.max_us,
+           (unsigned long)stats.busy_us);
+#else
+    (void)fs;
+    (void)name;
+#endif
+}
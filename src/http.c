@@ -0,0 +1,939 @@
+#include "inc/http.h"
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Estados da leitura da requisição */
+enum {
+    PARSE_METHOD,
+    PARSE_PATH,
+    PARSE_QUERY,
+    PARSE_VERSION,
+    PARSE_REQUEST_LF,       // '\n' depois do '\r' da linha de requisição
+    PARSE_HEADER_START,
+    PARSE_HEADER_NAME,
+    PARSE_HEADER_SPACE,     // Espaços entre ':' e o valor
+    PARSE_HEADER_VALUE,
+    PARSE_HEADER_LF,
+    PARSE_HEADERS_LF,       // '\n' da linha vazia que fecha os cabeçalhos
+    PARSE_BODY,
+    PARSE_DONE,
+    PARSE_ERROR
+};
+
+/* Cabeçalhos cujo valor é guardado */
+enum {
+    HEADER_NONE,
+    HEADER_CONNECTION,
+    HEADER_CONTENT_LENGTH,
+    HEADER_IF_NONE_MATCH,
+    HEADER_TRANSFER_ENCODING
+};
+
+/* Estados da conexão */
+enum {
+    CONN_READING,           // Lendo (ou esperando) uma requisição
+    CONN_WRITING,           // Enviando a resposta
+    CONN_CLOSING            // Resposta na fila; o tcp_close falhou e é tentado de novo em http_poll
+};
+
+// Intervalo do tcp_poll, em unidades de 500 ms do lwIP
+#define HTTP_POLL_INTERVAL  2
+
+/* Conexão HTTP aberta: a requisição que está chegando e a resposta que está saindo */
+struct HTTP_Conn {
+    struct tcp_pcb *pcb;            // NULL = posição livre
+    HTTP_Parser_t parser;
+    struct pbuf *held;              // Recebido e ainda não lido (próximas requisições)
+    uint16_t held_offset;           // Bytes de held já lidos
+    uint8_t state;
+    uint8_t idle;                   // Segundos sem receber nem ter dados confirmados
+    bool close;                     // Fecha a conexão no fim da resposta
+    bool overflow;                  // A resposta não coube no buffer
+    uint16_t buf_len;               // Bytes em buf
+    uint16_t buf_sent;              // Bytes de buf já passados ao lwIP
+    const uint8_t *ref;             // Resto do corpo de http_WriteRef (direto ao tcp_write)
+    uint32_t ref_len;
+    HTTP_Producer_t producer;       // Gerador do corpo de http_WriteStream (NULL = nenhum)
+    const void *producer_arg;
+    uint32_t cursor;
+    uint8_t buf[HTTP_BUFFER_SIZE];
+};
+
+static HTTP_Conn_t http_conns[HTTP_CONNECTIONS];
+static const HTTP_Route_t *http_routes;
+static uint8_t http_route_count;
+
+/**
+ * @brief Prepara a leitura de uma nova requisição.
+ *
+ */
+void http_ParserInit(HTTP_Parser_t *parser)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->state = PARSE_METHOD;
+}
+
+static HTTP_ParseResult_t http_parse_fail(HTTP_Parser_t *parser, uint16_t status)
+{
+    parser->state = PARSE_ERROR;
+    parser->status = status;
+    return HTTP_PARSE_ERROR;
+}
+
+static HTTP_ParseResult_t http_end_request_line(HTTP_Parser_t *parser)
+{
+    parser->token[parser->len] = '\0';
+    if (strncmp(parser->token, "HTTP/1.", 7) != 0 || parser->len != 8 || !isdigit((unsigned char)parser->token[7])) {
+        return http_parse_fail(parser, (strncmp(parser->token, "HTTP/", 5) == 0) ? 505 : 400);
+    }
+    parser->request.version = (uint8_t)(parser->token[7] - '0');
+    parser->state = PARSE_HEADER_START;
+    return HTTP_PARSE_MORE;
+}
+
+static HTTP_ParseResult_t http_end_header(HTTP_Parser_t *parser)
+{
+    HTTP_Request_t *request = &parser->request;
+    const bool truncated = (parser->len >= HTTP_VALUE_MAX);
+    uint16_t len = truncated ? HTTP_VALUE_MAX - 1 : parser->len;
+
+    while (len > 0 && (parser->token[len - 1] == ' ' || parser->token[len - 1] == '\t')) {
+        len--;
+    }
+    parser->token[len] = '\0';
+    parser->state = PARSE_HEADER_START;
+
+    switch (parser->header) {
+    case HEADER_CONNECTION:
+        for (uint16_t i = 0; i < len; i++) {
+            parser->token[i] = (char)tolower((unsigned char)parser->token[i]);
+        }
+        request->close |= (strstr(parser->token, "close") != NULL);
+        request->keep_alive |= (strstr(parser->token, "keep-alive") != NULL);
+        break;
+    case HEADER_CONTENT_LENGTH:
+        // Até 9 dígitos: cabe em 32 bits sem verificar estouro
+        if (len == 0 || len > 9 || truncated) {
+            return http_parse_fail(parser, 400);
+        }
+        request->content_length = 0;
+        for (uint16_t i = 0; i < len; i++) {
+            if (!isdigit((unsigned char)parser->token[i])) {
+                return http_parse_fail(parser, 400);
+            }
+            request->content_length = request->content_length * 10 + (uint32_t)(parser->token[i] - '0');
+        }
+        break;
+    case HEADER_IF_NONE_MATCH:
+        memcpy(request->if_none_match, parser->token, len + 1);
+        break;
+    case HEADER_TRANSFER_ENCODING:
+        // Corpo em chunks: não dá para saber onde termina sem decodificá-lo
+        return http_parse_fail(parser, 501);
+    default:
+        break;
+    }
+    return HTTP_PARSE_MORE;
+}
+
+static HTTP_ParseResult_t http_end_headers(HTTP_Parser_t *parser)
+{
+    parser->body = parser->request.content_length;
+    if (parser->body > 0) {
+        parser->state = PARSE_BODY;
+        return HTTP_PARSE_MORE;
+    }
+    parser->state = PARSE_DONE;
+    return HTTP_PARSE_DONE;
+}
+
+static void http_start_header(HTTP_Parser_t *parser)
+{
+    static const struct {
+        const char *name;
+        uint8_t header;
+    } headers[] = {
+        {"connection",          HEADER_CONNECTION},
+        {"content-length",      HEADER_CONTENT_LENGTH},
+        {"if-none-match",       HEADER_IF_NONE_MATCH},
+        {"transfer-encoding",   HEADER_TRANSFER_ENCODING},
+    };
+
+    parser->header = HEADER_NONE;
+    if (parser->len < HTTP_NAME_MAX) {
+        parser->token[parser->len] = '\0';
+        for (uint8_t i = 0; i < sizeof(headers) / sizeof(headers[0]); i++) {
+            if (strcmp(parser->token, headers[i].name) == 0) {
+                parser->header = headers[i].header;
+                break;
+            }
+        }
+    }
+    parser->len = 0;
+    parser->state = PARSE_HEADER_SPACE;
+}
+
+/**
+ * @brief Avança a máquina de estados um caractere (linha de requisição e cabeçalhos).
+ *
+ */
+static HTTP_ParseResult_t http_parse_char(HTTP_Parser_t *parser, char c)
+{
+    static const struct {
+        const char *name;
+        HTTP_Method_t method;
+    } methods[] = {
+        {"GET", HTTP_GET}, {"HEAD", HTTP_HEAD}, {"POST", HTTP_POST}, {"PUT", HTTP_PUT}, {"DELETE", HTTP_DELETE},
+    };
+    HTTP_Request_t *request = &parser->request;
+    const bool ctl = ((unsigned char)c < 0x20 || c == 0x7F);
+
+    switch (parser->state) {
+    case PARSE_METHOD:
+        if (c == ' ' && parser->len > 0) {
+            parser->token[parser->len] = '\0';
+            request->method = HTTP_OTHER;
+            for (uint8_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+                if (strcmp(parser->token, methods[i].name) == 0) {
+                    request->method = methods[i].method;
+                    break;
+                }
+            }
+            parser->len = 0;
+            parser->state = PARSE_PATH;
+        } else if (c >= 'A' && c <= 'Z' && parser->len < HTTP_VALUE_MAX - 1) {
+            parser->token[parser->len++] = c;
+        } else {
+            return http_parse_fail(parser, 400);
+        }
+        break;
+
+    case PARSE_PATH:
+    case PARSE_QUERY: {
+        char *out = (parser->state == PARSE_PATH) ? request->path : request->query;
+        const uint16_t max = (parser->state == PARSE_PATH) ? HTTP_PATH_MAX : HTTP_QUERY_MAX;
+
+        // Só a forma de origem ("/caminho?query"); "*" e URLs absolutas não são usadas aqui
+        if (parser->state == PARSE_PATH && parser->len == 0 && c != '/') {
+            return http_parse_fail(parser, 400);
+        }
+        if (c == ' ') {
+            parser->len = 0;
+            parser->state = PARSE_VERSION;
+        } else if (c == '?' && parser->state == PARSE_PATH) {
+            parser->len = 0;
+            parser->state = PARSE_QUERY;
+        } else if (ctl) {
+            return http_parse_fail(parser, 400);
+        } else if (parser->len >= max - 1) {
+            return http_parse_fail(parser, 414);
+        } else {
+            out[parser->len++] = c;
+        }
+        break;
+    }
+
+    case PARSE_VERSION:
+        if (c == '\r') {
+            parser->state = PARSE_REQUEST_LF;
+        } else if (c == '\n') {
+            return http_end_request_line(parser);
+        } else if (parser->len < HTTP_VALUE_MAX - 1 && !ctl) {
+            parser->token[parser->len++] = c;
+        } else {
+            return http_parse_fail(parser, 400);
+        }
+        break;
+
+    case PARSE_REQUEST_LF:
+        if (c != '\n') {
+            return http_parse_fail(parser, 400);
+        }
+        return http_end_request_line(parser);
+
+    case PARSE_HEADER_START:
+        if (c == '\r') {
+            parser->state = PARSE_HEADERS_LF;
+        } else if (c == '\n') {
+            return http_end_headers(parser);
+        } else if (c == ' ' || c == '\t') {
+            // Continuação da linha anterior (obsoleta no HTTP/1.1): ignorada
+            parser->header = HEADER_NONE;
+            parser->len = 0;
+            parser->state = PARSE_HEADER_VALUE;
+        } else if (c == ':' || ctl) {
+            return http_parse_fail(parser, 400);
+        } else {
+            parser->token[0] = (char)tolower((unsigned char)c);
+            parser->len = 1;
+            parser->state = PARSE_HEADER_NAME;
+        }
+        break;
+
+    case PARSE_HEADER_NAME:
+        if (c == ':') {
+            http_start_header(parser);
+        } else if (c == ' ' || c == '\t' || ctl) {
+            return http_parse_fail(parser, 400);
+        } else if (parser->len < HTTP_NAME_MAX) {
+            // Nomes maiores que HTTP_NAME_MAX - 1 ficam com len == HTTP_NAME_MAX e são ignorados
+            if (parser->len < HTTP_NAME_MAX - 1) {
+                parser->token[parser->len] = (char)tolower((unsigned char)c);
+            }
+            parser->len++;
+        }
+        break;
+
+    case PARSE_HEADER_SPACE:
+        if (c == ' ' || c == '\t') {
+            break;
+        }
+        parser->state = PARSE_HEADER_VALUE;
+        // fall through
+    case PARSE_HEADER_VALUE:
+        if (c == '\r') {
+            parser->state = PARSE_HEADER_LF;
+        } else if (c == '\n') {
+            return http_end_header(parser);
+        } else if (parser->len < HTTP_VALUE_MAX - 1) {
+            parser->token[parser->len++] = c;
+        } else {
+            parser->len = HTTP_VALUE_MAX;   // Valor cortado
+        }
+        break;
+
+    case PARSE_HEADER_LF:
+        if (c != '\n') {
+            return http_parse_fail(parser, 400);
+        }
+        return http_end_header(parser);
+
+    case PARSE_HEADERS_LF:
+        if (c != '\n') {
+            return http_parse_fail(parser, 400);
+        }
+        return http_end_headers(parser);
+
+    default:
+        break;
+    }
+    return HTTP_PARSE_MORE;
+}
+
+/**
+ * @brief Lê mais um pedaço da requisição.
+ *
+ * Pode ser chamada com qualquer divisão dos bytes (um pbuf por vez, por
+ * exemplo): o estado fica em parser. Para no fim da requisição; os bytes
+ * seguintes (uma próxima requisição) ficam para depois de http_ParserInit.
+ *
+ * @param used Recebe quantos bytes de data foram consumidos.
+ * @return HTTP_PARSE_DONE com a requisição completa em parser->request,
+ *         HTTP_PARSE_ERROR com o status da resposta em parser->status,
+ *         HTTP_PARSE_MORE se ainda faltam bytes.
+ */
+HTTP_ParseResult_t http_Parse(HTTP_Parser_t *parser, const char *data, uint16_t len, uint16_t *used)
+{
+    HTTP_ParseResult_t result = HTTP_PARSE_MORE;
+    uint16_t i = 0;
+
+    if (parser->state == PARSE_DONE || parser->state == PARSE_ERROR) {
+        *used = 0;
+        return (parser->state == PARSE_DONE) ? HTTP_PARSE_DONE : HTTP_PARSE_ERROR;
+    }
+
+    while (i < len && result == HTTP_PARSE_MORE) {
+        if (parser->state == PARSE_BODY) {
+            // O corpo não é usado por nenhuma rota: só é pulado
+            const uint16_t skip = (parser->body < (uint32_t)(len - i)) ? (uint16_t)parser->body : len - i;
+            parser->body -= skip;
+            i += skip;
+            if (parser->body == 0) {
+                parser->state = PARSE_DONE;
+                result = HTTP_PARSE_DONE;
+            }
+            continue;
+        }
+        if (++parser->size > HTTP_HEADERS_MAX) {
+            result = http_parse_fail(parser, 431);
+            break;
+        }
+        result = http_parse_char(parser, data[i++]);
+    }
+
+    *used = i;
+    return result;
+}
+
+/**
+ * @brief Procura name=valor na query string da requisição.
+ *
+ * @return O início do valor (termina em '&' ou no fim da string) ou NULL.
+ */
+const char* http_QueryValue(const HTTP_Request_t *request, const char *name)
+{
+    const size_t name_len = strlen(name);
+    const char *p = request->query;
+
+    while (*p) {
+        if (strncmp(p, name, name_len) == 0 && p[name_len] == '=') {
+            return &p[name_len + 1];
+        }
+        p = strchr(p, '&');
+        if (p == NULL) {
+            break;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+static const char* http_reason(uint16_t status)
+{
+    static const struct {
+        uint16_t status;
+        const char *reason;
+    } reasons[] = {
+        {200, "OK"},
+        {304, "Not Modified"},
+        {400, "Bad Request"},
+        {404, "Not Found"},
+        {405, "Method Not Allowed"},
+        {414, "URI Too Long"},
+        {431, "Request Header Fields Too Large"},
+        {500, "Internal Server Error"},
+        {501, "Not Implemented"},
+        {503, "Service Unavailable"},
+        {505, "HTTP Version Not Supported"},
+    };
+
+    for (uint8_t i = 0; i < sizeof(reasons) / sizeof(reasons[0]); i++) {
+        if (reasons[i].status == status) {
+            return reasons[i].reason;
+        }
+    }
+    return "Unknown";
+}
+
+// Acrescenta texto formatado ao buffer da resposta
+static void http_printf(HTTP_Conn_t *conn, const char *fmt, ...)
+{
+    const uint16_t room = HTTP_BUFFER_SIZE - conn->buf_len;
+    va_list args;
+
+    va_start(args, fmt);
+    const int len = vsnprintf((char *)&conn->buf[conn->buf_len], room, fmt, args);
+    va_end(args);
+
+    if (len < 0 || len >= room) {
+        conn->overflow = true;
+    } else {
+        conn->buf_len += (uint16_t)len;
+    }
+}
+
+/**
+ * @brief Começa a resposta: linha de status e cabeçalhos no buffer da conexão.
+ *
+ * Content-Type só vai se content_type não for NULL; headers são cabeçalhos a
+ * mais, cada um terminado em "\r\n". Com content_length HTTP_LENGTH_UNKNOWN o
+ * corpo termina no fechamento da conexão, então ela não é reaproveitada.
+ *
+ * @return false se o cabeçalho não coube em HTTP_BUFFER_SIZE (a conexão é abortada).
+ */
+bool http_Begin(HTTP_Conn_t *conn, uint16_t status, const char *content_type, int32_t content_length,
+                const char *headers)
+{
+    if (content_length < 0) {
+        conn->close = true;
+    }
+
+    http_printf(conn, "HTTP/1.1 %u %s\r\n", status, http_reason(status));
+    if (content_type != NULL) {
+        http_printf(conn, "Content-Type: %s\r\n", content_type);
+    }
+    if (content_length >= 0) {
+        http_printf(conn, "Content-Length: %ld\r\n", (long)content_length);
+    }
+    http_printf(conn, "%sConnection: %s\r\n\r\n", headers ? headers : "", conn->close ? "close" : "keep-alive");
+    return !conn->overflow;
+}
+
+/**
+ * @brief Copia data para o buffer da resposta (corpos pequenos).
+ *
+ * @return false se não coube em HTTP_BUFFER_SIZE (a conexão é abortada).
+ */
+bool http_Write(HTTP_Conn_t *conn, const void *data, uint16_t len)
+{
+    if (len > HTTP_BUFFER_SIZE - conn->buf_len) {
+        conn->overflow = true;
+        return false;
+    }
+    memcpy(&conn->buf[conn->buf_len], data, len);
+    conn->buf_len += len;
+    return true;
+}
+
+/**
+ * @brief Termina o corpo com len bytes de data, passados direto ao tcp_write.
+ *
+ * data não passa pelo buffer da conexão e precisa continuar valendo até o fim
+ * da resposta (const na flash, por exemplo): vai sem TCP_WRITE_FLAG_COPY, e o
+ * lwIP pode apontar para ele até o navegador confirmar o recebimento. Com
+ * LWIP_NETIF_TX_SINGLE_PBUF o lwIP copia os dados para o heap mesmo assim.
+ */
+void http_WriteRef(HTTP_Conn_t *conn, const void *data, uint32_t len)
+{
+    conn->ref = (const uint8_t *)data;
+    conn->ref_len = len;
+}
+
+/**
+ * @brief Termina o corpo com o que producer gerar, aos pedaços, no buffer da conexão.
+ *
+ * producer é chamado de novo a cada vez que o pedaço anterior foi todo para a
+ * fila do lwIP, até devolver 0. O tamanho total deve ser o Content-Length
+ * passado a http_Begin (ou HTTP_LENGTH_UNKNOWN).
+ */
+void http_WriteStream(HTTP_Conn_t *conn, HTTP_Producer_t producer, const void *arg)
+{
+    conn->producer = producer;
+    conn->producer_arg = arg;
+    conn->cursor = 0;
+}
+
+/**
+ * @brief Responde com um status de erro e uma linha de texto.
+ *
+ */
+void http_SendError(HTTP_Conn_t *conn, uint16_t status)
+{
+    char body[48];
+    const int len = snprintf(body, sizeof(body), "%u %s\n", status, http_reason(status));
+
+    http_Begin(conn, status, "text/plain", len, NULL);
+    http_Write(conn, body, (uint16_t)len);
+}
+
+static void http_reset_response(HTTP_Conn_t *conn)
+{
+    conn->state = CONN_READING;
+    conn->overflow = false;
+    conn->buf_len = 0;
+    conn->buf_sent = 0;
+    conn->ref = NULL;
+    conn->ref_len = 0;
+    conn->producer = NULL;
+}
+
+/**
+ * @brief Desliga os callbacks do servidor da conexão e libera sua posição.
+ *
+ */
+static void http_release(HTTP_Conn_t *conn)
+{
+    struct tcp_pcb *tpcb = conn->pcb;
+
+    tcp_arg(tpcb, NULL);
+    tcp_recv(tpcb, NULL);
+    tcp_sent(tpcb, NULL);
+    tcp_err(tpcb, NULL);
+    tcp_poll(tpcb, NULL, 0);
+    if (conn->held != NULL) {
+        // O que sobrou não vai ser lido: devolve a janela mesmo assim
+        tcp_recved(tpcb, conn->held->tot_len - conn->held_offset);
+        pbuf_free(conn->held);
+        conn->held = NULL;
+    }
+    conn->pcb = NULL;
+}
+
+static err_t http_abort(HTTP_Conn_t *conn)
+{
+    struct tcp_pcb *tpcb = conn->pcb;
+    http_release(conn);
+    tcp_abort(tpcb);
+    return ERR_ABRT;
+}
+
+static err_t http_poll(void *arg, struct tcp_pcb *tpcb);
+static void http_error(void *arg, err_t err);
+
+/**
+ * @brief Fecha a conexão; o que já está na fila do lwIP ainda é enviado antes do FIN.
+ *
+ */
+static err_t http_close(HTTP_Conn_t *conn)
+{
+    struct tcp_pcb *tpcb = conn->pcb;
+
+    http_release(conn);
+    if (tcp_close(tpcb) == ERR_OK) {
+        return ERR_OK;
+    }
+
+    // Sem memória para o FIN: a conexão volta para a posição e http_poll tenta de novo
+    conn->pcb = tpcb;
+    conn->state = CONN_CLOSING;
+    tcp_arg(tpcb, conn);
+    tcp_err(tpcb, http_error);
+    tcp_poll(tpcb, http_poll, HTTP_POLL_INTERVAL);
+    return ERR_OK;
+}
+
+/**
+ * @brief Passa a conexão para outro dono (a transmissão da tela, por exemplo).
+ *
+ * Chamada de dentro de um handler, no lugar de uma resposta: o servidor para
+ * de ler a conexão e o novo dono instala os próprios callbacks.
+ *
+ * @return O pcb da conexão.
+ */
+struct tcp_pcb* http_Detach(HTTP_Conn_t *conn)
+{
+    struct tcp_pcb *tpcb = conn->pcb;
+    http_release(conn);
+    return tpcb;
+}
+
+// Resposta toda na fila do lwIP: fecha ou espera a próxima requisição
+static err_t http_finish(HTTP_Conn_t *conn)
+{
+    http_reset_response(conn);
+    if (conn->close) {
+        return http_close(conn);
+    }
+    http_ParserInit(&conn->parser);
+    return ERR_OK;
+}
+
+/**
+ * @brief Passa para o lwIP o que couber da resposta.
+ *
+ * O limite é tcp_sndbuf (e a fila de segmentos: tcp_write devolve ERR_MEM).
+ * O buffer da conexão vai com TCP_WRITE_FLAG_COPY; o bloco de http_WriteRef
+ * vai sem (o lwIP ainda copia com LWIP_NETIF_TX_SINGLE_PBUF).
+ * Quando o buffer foi todo para a fila, o produtor de http_WriteStream gera o
+ * próximo pedaço nele. O que não couber agora sai em http_sent, quando o
+ * navegador confirmar os dados anteriores.
+ */
+static err_t http_flush(HTTP_Conn_t *conn)
+{
+    struct tcp_pcb *tpcb = conn->pcb;
+    bool queued = false;
+
+    if (conn->overflow) {
+        return http_abort(conn);
+    }
+
+    while (1) {
+        const uint16_t space = tcp_sndbuf(tpcb);
+
+        if (conn->buf_sent < conn->buf_len) {
+            const uint16_t left = conn->buf_len - conn->buf_sent;
+            const uint16_t n = (left < space) ? left : space;
+            const bool more = (n < left || conn->ref_len > 0 || conn->producer != NULL);
+            if (n == 0 || tcp_write(tpcb, &conn->buf[conn->buf_sent], n,
+                                    TCP_WRITE_FLAG_COPY | (more ? TCP_WRITE_FLAG_MORE : 0)) != ERR_OK) {
+                break;
+            }
+            conn->buf_sent += n;
+            queued = true;
+        } else if (conn->ref_len > 0) {
+            const uint16_t n = (conn->ref_len < space) ? (uint16_t)conn->ref_len : space;
+            const bool more = (n < conn->ref_len || conn->producer != NULL);
+            if (n == 0 || tcp_write(tpcb, conn->ref, n, more ? TCP_WRITE_FLAG_MORE : 0) != ERR_OK) {
+                break;
+            }
+            conn->ref += n;
+            conn->ref_len -= n;
+            queued = true;
+        } else if (conn->producer != NULL) {
+            conn->buf_len = conn->producer(conn->producer_arg, &conn->cursor, conn->buf, HTTP_BUFFER_SIZE);
+            conn->buf_sent = 0;
+            if (conn->buf_len == 0) {
+                conn->producer = NULL;
+            }
+        } else {
+            if (queued) {
+                tcp_output(tpcb);
+            }
+            return http_finish(conn);
+        }
+    }
+
+    if (queued) {
+        tcp_output(tpcb);
+    }
+    return ERR_OK;
+}
+
+/**
+ * @brief Procura a rota da requisição e chama o handler.
+ *
+ * Sem rota para o caminho a resposta é 404; com o caminho mas outro método, 405.
+ */
+static void http_dispatch(HTTP_Conn_t *conn, const HTTP_Request_t *request)
+{
+    bool path_found = false;
+
+    for (uint8_t i = 0; i < http_route_count; i++) {
+        const HTTP_Route_t *route = &http_routes[i];
+        if (strcmp(route->path, request->path) != 0) {
+            continue;
+        }
+        path_found = true;
+        if (route->method == request->method) {
+            route->handler(conn, request, route->arg);
+            return;
+        }
+    }
+    http_SendError(conn, path_found ? 405 : 404);
+}
+
+// Requisição completa: chama a rota e começa a enviar a resposta
+static err_t http_respond(HTTP_Conn_t *conn)
+{
+    const HTTP_Request_t *request = &conn->parser.request;
+
+    // HTTP/1.1 mantém a conexão por padrão; HTTP/1.0 só com "Connection: keep-alive"
+    conn->close = request->close || (request->version == 0 && !request->keep_alive);
+    conn->state = CONN_WRITING;
+
+    http_dispatch(conn, request);
+    if (conn->pcb == NULL) {
+        return ERR_OK;  // A conexão mudou de dono (http_Detach)
+    }
+    if (conn->buf_len == 0 && conn->ref_len == 0 && conn->producer == NULL) {
+        http_SendError(conn, 500);  // O handler não respondeu nada
+    }
+    return http_flush(conn);
+}
+
+/**
+ * @brief Lê o que foi recebido e responde as requisições completas.
+ *
+ * Cada pbuf da cadeia é lido pela máquina de estados sem copiar nem procurar
+ * nada no payload, e os bytes lidos são devolvidos à janela TCP (tcp_recved).
+ * Enquanto uma resposta está saindo, o resto (a próxima requisição de um
+ * navegador que não espera a resposta) fica guardado sem ser confirmado, e o
+ * próprio TCP segura o cliente.
+ */
+static err_t http_process(HTTP_Conn_t *conn)
+{
+    err_t ret = ERR_OK;
+
+    while (ret == ERR_OK && conn->pcb != NULL && conn->state == CONN_READING && conn->held != NULL) {
+        struct pbuf *q = conn->held;
+        uint16_t offset = conn->held_offset;
+        uint16_t used;
+
+        while (offset >= q->len) {
+            offset -= q->len;
+            q = q->next;
+        }
+        const HTTP_ParseResult_t result = http_Parse(&conn->parser, (const char *)q->payload + offset,
+                                                     q->len - offset, &used);
+        tcp_recved(conn->pcb, used);
+        conn->held_offset += used;
+        if (conn->held_offset >= conn->held->tot_len) {
+            pbuf_free(conn->held);
+            conn->held = NULL;
+            conn->held_offset = 0;
+        }
+
+        if (result == HTTP_PARSE_DONE) {
+            ret = http_respond(conn);
+        } else if (result == HTTP_PARSE_ERROR) {
+            // Depois de um erro não dá para saber onde começa a próxima requisição
+            conn->state = CONN_WRITING;
+            conn->close = true;
+            http_SendError(conn, conn->parser.status);
+            ret = http_flush(conn);
+        }
+    }
+    return ret;
+}
+
+static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    HTTP_Conn_t *conn = (HTTP_Conn_t *)arg;
+
+    if (conn == NULL) {
+        if (p != NULL) {
+            tcp_recved(tpcb, p->tot_len);
+            pbuf_free(p);
+        }
+        return ERR_OK;
+    }
+
+    if (p == NULL) {
+        // O cliente não vai mandar mais nada: fecha agora ou no fim da resposta
+        if (conn->state == CONN_WRITING) {
+            conn->close = true;
+            return ERR_OK;
+        }
+        return http_close(conn);
+    }
+
+    conn->idle = 0;
+    if (conn->held == NULL) {
+        conn->held = p;
+        conn->held_offset = 0;
+    } else {
+        pbuf_cat(conn->held, p);
+    }
+    return http_process(conn);
+}
+
+// Dados confirmados pelo navegador: continua a resposta e depois as requisições guardadas
+static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+    HTTP_Conn_t *conn = (HTTP_Conn_t *)arg;
+    err_t ret = ERR_OK;
+
+    if (conn == NULL) {
+        return ERR_OK;
+    }
+    conn->idle = 0;
+    if (conn->state == CONN_WRITING) {
+        ret = http_flush(conn);
+    }
+    if (ret == ERR_OK && conn->pcb != NULL) {
+        ret = http_process(conn);
+    }
+    return ret;
+}
+
+/**
+ * @brief Chamada pelo lwIP a cada segundo enquanto a conexão existe.
+ *
+ * Tenta de novo o que falhou por falta de memória (tcp_write, tcp_close) e
+ * fecha conexões paradas há HTTP_IDLE_TIMEOUT_S: um keep-alive esquecido pelo
+ * navegador ou um cliente que parou de confirmar a resposta.
+ */
+static err_t http_poll(void *arg, struct tcp_pcb *tpcb)
+{
+    HTTP_Conn_t *conn = (HTTP_Conn_t *)arg;
+
+    if (conn == NULL) {
+        return ERR_OK;
+    }
+
+    if (++conn->idle >= HTTP_IDLE_TIMEOUT_S) {
+        return (conn->state == CONN_READING) ? http_close(conn) : http_abort(conn);
+    }
+    if (conn->state == CONN_CLOSING) {
+        return http_close(conn);
+    }
+    if (conn->state == CONN_WRITING) {
+        return http_flush(conn);
+    }
+    return ERR_OK;
+}
+
+// Conexão abortada (reset, falta de memória): o lwIP já liberou o pcb
+static void http_error(void *arg, err_t err)
+{
+    HTTP_Conn_t *conn = (HTTP_Conn_t *)arg;
+
+    if (conn != NULL) {
+        if (conn->held != NULL) {
+            pbuf_free(conn->held);
+            conn->held = NULL;
+        }
+        conn->pcb = NULL;
+    }
+}
+
+/**
+ * @brief Procura uma posição livre; sem nenhuma, fecha o keep-alive parado há mais tempo.
+ *
+ */
+static HTTP_Conn_t* http_alloc(void)
+{
+    HTTP_Conn_t *idle = NULL;
+
+    for (uint8_t i = 0; i < HTTP_CONNECTIONS; i++) {
+        HTTP_Conn_t *conn = &http_conns[i];
+        if (conn->pcb == NULL) {
+            return conn;
+        }
+        // Parada entre duas requisições, sem nada lido pela metade
+        if (conn->state == CONN_READING && conn->held == NULL && conn->parser.size == 0 &&
+            (idle == NULL || conn->idle > idle->idle)) {
+            idle = conn;
+        }
+    }
+
+    if (idle != NULL) {
+        http_close(idle);
+        if (idle->pcb == NULL) {
+            return idle;
+        }
+    }
+    return NULL;
+}
+
+static err_t http_accept(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+    if (err != ERR_OK || newpcb == NULL) {
+        return ERR_VAL;
+    }
+
+    HTTP_Conn_t *conn = http_alloc();
+    if (conn == NULL) {
+        tcp_abort(newpcb);
+        return ERR_ABRT;
+    }
+
+    conn->pcb = newpcb;
+    conn->held = NULL;
+    conn->held_offset = 0;
+    conn->idle = 0;
+    conn->close = false;
+    http_reset_response(conn);
+    http_ParserInit(&conn->parser);
+
+    // Respostas pequenas de keep-alive não devem esperar o ACK da anterior
+    tcp_nagle_disable(newpcb);
+    tcp_arg(newpcb, conn);
+    tcp_recv(newpcb, http_recv);
+    tcp_sent(newpcb, http_sent);
+    tcp_err(newpcb, http_error);
+    tcp_poll(newpcb, http_poll, HTTP_POLL_INTERVAL);
+    return ERR_OK;
+}
+
+/**
+ * @brief Abre o servidor HTTP na porta indicada com a tabela de rotas.
+ *
+ * A tabela não é copiada: precisa continuar existindo (normalmente é const).
+ *
+ * @return false se o lwIP não conseguiu criar ou ligar o PCB de escuta.
+ */
+bool http_Start(uint16_t port, const HTTP_Route_t *routes, uint8_t count)
+{
+    struct tcp_pcb *pcb = tcp_new();
+    if (pcb == NULL) {
+        return false;
+    }
+    if (tcp_bind(pcb, IP_ADDR_ANY, port) != ERR_OK) {
+        tcp_close(pcb);
+        return false;
+    }
+
+    struct tcp_pcb *listen = tcp_listen(pcb);
+    if (listen == NULL) {
+        tcp_close(pcb);
+        return false;
+    }
+
+    http_routes = routes;
+    http_route_count = count;
+    tcp_accept(listen, http_accept);
+    return true;
+}
@@ -30,6 +30,23 @@ const unsigned char bitmap_item_sel_outline [] = {
   0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0
 };
 
+// Ícones 8x8 da barra de status (acesos sobre fundo apagado)
+const unsigned char bitmap_status_wifi[] = {
+  0x00, 0x3c, 0x42, 0x99, 0x24, 0x00, 0x18, 0x00
+};
+
+const unsigned char bitmap_status_wifi_off[] = {
+  0x00, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x00
+};
+
+const unsigned char bitmap_status_cloud[] = {
+  0x00, 0x0c, 0x32, 0x41, 0x81, 0x7e, 0x00, 0x00
+};
+
+const unsigned char bitmap_status_upload[] = {
+  0x00, 0x18, 0x3c, 0x7e, 0x18, 0x18, 0x18, 0x00
+};
+
 
 char menu_items[NUM_ITEMS][MAX_ITEM_LENGTH] = {
     "Joystick",
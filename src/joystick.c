@@ -133,11 +133,25 @@ void joystick_pos(void)
     const uint8_t rectY_x = 68;
     const uint8_t rectY_y = 16;
 
+    // Leitura e redesenho a 30 fps
+    FRAME_Scheduler_t fs;
+    frame_Init(&fs, 30, 0);
+
     while (1)
     {
+        frame_Begin(&fs);
+        idle_poll();
+
         // Lê os valores dos eixos do joystick
         joystick_read_axis(&vrx_value, &vry_value);
 
+        // Joystick fora do centro conta como atividade (acorda o display)
+        if (vrx_value < JOYSTICK_LEFT_THRESHOLD || vrx_value > JOYSTICK_RIGHT_THRESHOLD ||
+            vry_value < JOYSTICK_LEFT_THRESHOLD || vry_value > JOYSTICK_RIGHT_THRESHOLD)
+        {
+            ssd1306_IdleKick();
+        }
+
         // Preenche o display com fundo branco
         ssd1306_Fill(White);
 
@@ -168,17 +182,18 @@ void joystick_pos(void)
         ssd1306_WriteString(buffer, Font_7x10, Black);
 
         // Atualiza o display para aplicar as alterações
-        ssd1306_UpdateScreen();
+        ssd1306_UpdateScreenAsync();
 
         // Verifica se o pino 22 foi pressionado para sair da função
-        if(gpio_get(22) == 0) 
+        if(idle_button()) 
         {
             DEBOUNCE;
+            frame_PrintStats(&fs, "joystick");
             joystick_home();
             break;
         }
 
-        POLLING_TIME;
+        frame_End(&fs);
     }
 }
 
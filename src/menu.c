@@ -11,6 +11,28 @@ static uint8_t posicao_selecao_mic      = JOYSTICK_RGB;
 static uint8_t posicao_selecao_display  = JOYSTICK_RGB;
 static uint8_t posicao_selecao_wifi     = JOYSTICK_RGB;
 
+/*
+ * Função: submenu_update
+ * ----------------------
+ * Os submenus são tabelas de widgets (inc/ui.h): três rótulos e o destaque da
+ * seleção, que é sempre o último widget. Com full = true a tela é desenhada do
+ * zero (ao entrar no menu); senão só o destaque é movido e apenas as duas
+ * linhas afetadas são redesenhadas e enviadas ao display.
+ */
+static void submenu_update(UI_Screen_t *screen, uint8_t selection, bool full) {
+    // Posição vertical do destaque para cada opção
+    static const uint8_t highlight_y[] = { 1, 23, 45 };
+    UI_Widget_t *highlight = &screen->widgets[screen->count - 1];
+
+    ssd1306_IdleKick();  // Movimento do joystick ou entrada no menu: acorda o display
+    ui_MoveTo(screen, highlight, highlight->x, highlight_y[(selection <= MENU) ? selection : JOYSTICK_RGB]);
+    if (full) {
+        ui_Show(screen);
+    } else {
+        ui_Render(screen);
+    }
+}
+
 /*
  * Função: joystick_update_menu
  * ----------------------------
@@ -18,33 +40,16 @@ static uint8_t posicao_selecao_wifi     = JOYSTICK_RGB;
  * O menu mostra as opções "JoyStick POS", "JoyStick RGB" e "Menu Principal"
  * com um destaque (bitmap) posicionado de acordo com a seleção atual.
  */
-static void joystick_update_menu(void) {
-    uint8_t pos_y;
-    // Determina a posição vertical do destaque com base na seleção atual
-    switch(posicao_selecao_joystick) {
-        case JOYSTICK_POS:
-            pos_y = 1;
-            break;
-        case JOYSTICK_RGB:
-            pos_y = 23;
-            break;
-        case MENU:
-            pos_y = 45;
-            break;
-        default:
-            pos_y = 23;
-    }
-    // Limpa o display e desenha as opções do menu
-    ssd1306_Fill(White);
-    ssd1306_SetCursor(5, 5);
-    ssd1306_WriteString("JoyStick POS", Font_7x10, Black);
-    ssd1306_SetCursor(5, 27);
-    ssd1306_WriteString("JoyStick RGB", Font_7x10, Black);
-    ssd1306_SetCursor(5, 49);
-    ssd1306_WriteString("Menu Principal", Font_7x10, Black);
-    // Desenha o destaque utilizando um bitmap na posição definida
-    ssd1306_DrawBitmap(0, pos_y, bitmap_item_sel_outline, 128, 19, Black);
-    ssd1306_UpdateScreen();
+static UI_Widget_t joystick_widgets[] = {
+    { .type = UI_LABEL, .x = 5, .y = 5,  .color = Black, .text = "JoyStick POS", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 27, .color = Black, .text = "JoyStick RGB", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 49, .color = Black, .text = "Menu Principal", .font = &Font_7x10 },
+    { .type = UI_HIGHLIGHT, .x = 0, .y = 23, .color = Black, .bitmap = &bitmap_item_sel_outline_pages },
+};
+static UI_Screen_t joystick_menu = UI_SCREEN(joystick_widgets, White);
+
+static void joystick_update_menu(bool full) {
+    submenu_update(&joystick_menu, posicao_selecao_joystick, full);
 }
 
 /*
@@ -58,11 +63,15 @@ void joystick_home(void) {
     // Seleciona o canal ADC para a leitura do joystick
     adc_select_input(0);
     bool can_move = true;
-    joystick_update_menu();
+    joystick_update_menu(true);
 
     while(1) {
         uint32_t adc_val_y = adc_read();
         uint8_t prev = posicao_selecao_joystick;
+        // Qualquer movimento acorda o display; o que o acordou não move a seleção
+        if (idle_joystick(adc_val_y)) {
+            can_move = false;
+        }
         
         // Ajusta a seleção conforme o valor do ADC (movimento para cima ou para baixo)
         if(adc_val_y > 3800 && can_move) {
@@ -77,10 +86,10 @@ void joystick_home(void) {
         
         // Se a seleção mudar, atualiza o menu
         if(prev != posicao_selecao_joystick)
-            joystick_update_menu();
+            joystick_update_menu(false);
         
         // Se o botão for pressionado, executa a ação correspondente à opção selecionada
-        if(gpio_get(JOYSTICK_BUTTON) == 0) {
+        if(idle_button()) {
             DEBOUNCE;
             if(posicao_selecao_joystick == MENU) {
                 // Retorna ao menu principal
@@ -105,7 +114,7 @@ void joystick_home(void) {
  * Inicializa e exibe o menu do joystick.
  */
 void joystick_screen(void) {
-    joystick_update_menu();
+    joystick_update_menu(true);
     joystick_home();
 }
 
@@ -117,10 +126,23 @@ void joystick_screen(void) {
  * Função: updateHomeScreen
  * -------------------------
  * Atualiza a tela do menu principal com base na opção atual.
- * Mostra o título "MENU" e a opção selecionada centralizada em um retângulo.
+ * Mostra o título "MENU" e a opção selecionada centralizada em um retângulo,
+ * entre duas setas. Com full = false só o campo com o nome da opção é
+ * redesenhado e enviado.
  */
-static void updateHomeScreen(uint8_t option) {
-    char* messages[TOTAL_OPTIONS] = {
+static UI_Widget_t home_widgets[] = {
+    { .type = UI_FILL,        .x = 2,   .y = 2,  .w = 124, .h = 11, .color = Black },
+    { .type = UI_LABEL,       .x = 48,  .y = 3,  .color = White, .text = "MENU", .font = &Font_7x10 },
+    { .type = UI_BOX,         .x = 3,   .y = 14, .w = 123, .h = 49, .color = Black },
+    { .type = UI_VALUE,       .x = 13,  .y = 33, .w = 101, .h = 10, .color = Black, .text = "", .font = &Font_7x10 },
+    { .type = UI_ARROW_LEFT,  .x = 4,   .y = 30, .w = 9,   .h = 17, .color = Black },
+    { .type = UI_ARROW_RIGHT, .x = 115, .y = 30, .w = 9,   .h = 17, .color = Black },
+};
+static UI_Screen_t home_menu = UI_SCREEN(home_widgets, White);
+#define HOME_OPTION_TEXT 3
+
+static void updateHomeScreen(uint8_t option, bool full) {
+    static const char* messages[TOTAL_OPTIONS] = {
         "Demo Joystick",
         "Demo Matriz",
         "Demo Buzzer",
@@ -128,27 +150,13 @@ static void updateHomeScreen(uint8_t option) {
         "Demo Display",
         "Demo Wifi"
     };
-    char* optionText = messages[option - 1];
-    ssd1306_Fill(White);
-    // Desenha o cabeçalho do menu
-    ssd1306_FillRectangle(2, 2, 125, 12, Black);
-    ssd1306_SetCursor(48, 3);
-    ssd1306_WriteString("MENU", Font_7x10, White);
-    // Desenha o retângulo que contém a opção atual
-    ssd1306_DrawRectangle(3, 14, 125, 62, Black);
-    
-    // Centraliza o texto da opção atual
-    uint8_t textWidth = strlen(optionText) * 7;
-    uint8_t availableWidth = 123;
-    uint8_t x = 2 + (availableWidth - textWidth) / 2;
-    uint8_t y = 14 + (48 - 10) / 2;
-    ssd1306_SetCursor(x, y);
-    ssd1306_WriteString(optionText, Font_7x10, Black);
-    
-    // Desenha setas (triângulos) nas laterais
-    drawFilledTriangle(4, 38, 12, 30, 12, 46, Black);
-    drawFilledTriangle(123, 38, 115, 30, 115, 46, Black);
-    ssd1306_UpdateScreen();
+    ssd1306_IdleKick();  // Movimento do joystick ou volta ao menu: acorda o display
+    ui_SetText(&home_menu, &home_widgets[HOME_OPTION_TEXT], messages[option - 1]);
+    if (full) {
+        ui_Show(&home_menu);
+    } else {
+        ui_Render(&home_menu);
+    }
 }
 
 /*-----------------------------------------------------------
@@ -179,30 +187,16 @@ void demo_matriz(void) {
  * Atualiza a tela do menu da matriz, exibindo as opções "Matriz RGB", "Matriz Jogo"
  * e "Menu Principal", com destaque conforme a seleção.
  */
-static void matriz_update_menu(void) {
-    uint8_t pos_y;
-    switch(posicao_selecao_matriz) {
-        case JOYSTICK_POS:
-            pos_y = 1;
-            break;
-        case JOYSTICK_RGB:
-            pos_y = 23;
-            break;
-        case MENU:
-            pos_y = 45;
-            break;
-        default:
-            pos_y = 23;
-    }
-    ssd1306_Fill(White);
-    ssd1306_SetCursor(5, 5);
-    ssd1306_WriteString("Matriz RGB", Font_7x10, Black);
-    ssd1306_SetCursor(5, 27);
-    ssd1306_WriteString("Matriz Jogo", Font_7x10, Black);
-    ssd1306_SetCursor(5, 49);
-    ssd1306_WriteString("Menu Principal", Font_7x10, Black);
-    ssd1306_DrawBitmap(1, pos_y, bitmap_item_sel_outline, 128, 19, Black);
-    ssd1306_UpdateScreen();
+static UI_Widget_t matriz_widgets[] = {
+    { .type = UI_LABEL, .x = 5, .y = 5,  .color = Black, .text = "Matriz RGB", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 27, .color = Black, .text = "Matriz Jogo", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 49, .color = Black, .text = "Menu Principal", .font = &Font_7x10 },
+    { .type = UI_HIGHLIGHT, .x = 1, .y = 23, .color = Black, .bitmap = &bitmap_item_sel_outline_pages },
+};
+static UI_Screen_t matriz_menu = UI_SCREEN(matriz_widgets, White);
+
+static void matriz_update_menu(bool full) {
+    submenu_update(&matriz_menu, posicao_selecao_matriz, full);
 }
 
 /*
@@ -214,11 +208,15 @@ static void matriz_update_menu(void) {
 void matriz_home(void) {
     adc_select_input(0);
     bool can_move = true;
-    matriz_update_menu();
+    matriz_update_menu(true);
     
     while(1) {
         uint32_t adc_val_y = adc_read();
         uint8_t prev = posicao_selecao_matriz;
+        // Qualquer movimento acorda o display; o que o acordou não move a seleção
+        if (idle_joystick(adc_val_y)) {
+            can_move = false;
+        }
         
         // Atualiza a seleção conforme o valor do ADC
         if(adc_val_y > 3800 && can_move) {
@@ -232,10 +230,10 @@ void matriz_home(void) {
         }
         
         if(prev != posicao_selecao_matriz)
-            matriz_update_menu();
+            matriz_update_menu(false);
         
         // Se o botão for pressionado, executa a ação da opção selecionada
-        if(gpio_get(JOYSTICK_BUTTON) == 0) {
+        if(idle_button()) {
             DEBOUNCE;
             if(posicao_selecao_matriz == MENU) {
                 adc_select_input(1);
@@ -258,7 +256,7 @@ void matriz_home(void) {
  * Inicializa e exibe o menu da matriz.
  */
 void matriz_screen(void) {
-    matriz_update_menu();
+    matriz_update_menu(true);
     matriz_home();
 }
 
@@ -277,30 +275,16 @@ void demo_buzzer(void) {
  * Atualiza a tela do menu do buzzer, exibindo as opções "Asa Branca", "Mario Tema"
  * e "Menu Principal", com destaque de acordo com a seleção atual.
  */
-static void buzzer_update_menu(void) {
-    uint8_t pos_y;
-    switch(posicao_selecao_buzzer) {
-        case JOYSTICK_POS:
-            pos_y = 1;
-            break;
-        case JOYSTICK_RGB:
-            pos_y = 23;
-            break;
-        case MENU:
-            pos_y = 45;
-            break;
-        default:
-            pos_y = 23;
-    }
-    ssd1306_Fill(White);
-    ssd1306_SetCursor(5, 5);
-    ssd1306_WriteString("Asa Branca", Font_7x10, Black);
-    ssd1306_SetCursor(5, 27);
-    ssd1306_WriteString("Mario Tema", Font_7x10, Black);
-    ssd1306_SetCursor(5, 49);
-    ssd1306_WriteString("Menu Principal", Font_7x10, Black);
-    ssd1306_DrawBitmap(1, pos_y, bitmap_item_sel_outline, 128, 19, Black);
-    ssd1306_UpdateScreen();
+static UI_Widget_t buzzer_widgets[] = {
+    { .type = UI_LABEL, .x = 5, .y = 5,  .color = Black, .text = "Asa Branca", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 27, .color = Black, .text = "Mario Tema", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 49, .color = Black, .text = "Menu Principal", .font = &Font_7x10 },
+    { .type = UI_HIGHLIGHT, .x = 1, .y = 23, .color = Black, .bitmap = &bitmap_item_sel_outline_pages },
+};
+static UI_Screen_t buzzer_menu = UI_SCREEN(buzzer_widgets, White);
+
+static void buzzer_update_menu(bool full) {
+    submenu_update(&buzzer_menu, posicao_selecao_buzzer, full);
 }
 
 /*
@@ -312,10 +296,14 @@ static void buzzer_update_menu(void) {
 void buzzer_home(void) {
     adc_select_input(0);
     bool can_move = true;
-    buzzer_update_menu();
+    buzzer_update_menu(true);
     while(1) {
         uint32_t adc_val = adc_read();
         uint8_t prev = posicao_selecao_buzzer;
+        // Qualquer movimento acorda o display; o que o acordou não move a seleção
+        if (idle_joystick(adc_val)) {
+            can_move = false;
+        }
         // Ajusta a seleção conforme o valor do ADC
         if(adc_val > 3800 && can_move) {
             posicao_selecao_buzzer = (posicao_selecao_buzzer == JOYSTICK_POS) ? MENU : posicao_selecao_buzzer - 1;
@@ -327,10 +315,10 @@ void buzzer_home(void) {
             can_move = true;
         }
         if(prev != posicao_selecao_buzzer)
-            buzzer_update_menu();
+            buzzer_update_menu(false);
 
         // Se o botão for pressionado, executa a ação selecionada
-        if(gpio_get(JOYSTICK_BUTTON) == 0) {
+        if(idle_button()) {
             DEBOUNCE;
             if(posicao_selecao_buzzer == MENU) {
                 home(3);
@@ -354,7 +342,7 @@ void buzzer_home(void) {
  * Inicializa e exibe o menu do buzzer.
  */
 void buzzer_screen(void) {
-    buzzer_update_menu();
+    buzzer_update_menu(true);
     buzzer_home();
 }
 
@@ -373,30 +361,16 @@ void demo_mic(void) {
  * Atualiza a tela do menu do microfone, exibindo as opções "Teste Mic",
  * "Mic Matriz" e "Menu Principal", com destaque na opção selecionada.
  */
-static void mic_update_menu(void) {
-    uint8_t pos_y;
-    switch(posicao_selecao_mic) {
-        case JOYSTICK_POS:
-            pos_y = 1;
-            break;
-        case JOYSTICK_RGB:
-            pos_y = 23;
-            break;
-        case MENU:
-            pos_y = 45;
-            break;
-        default:
-            pos_y = 23;
-    }
-    ssd1306_Fill(White);
-    ssd1306_SetCursor(5, 5);
-    ssd1306_WriteString("Teste Mic", Font_7x10, Black);
-    ssd1306_SetCursor(5, 27);
-    ssd1306_WriteString("Mic Matriz", Font_7x10, Black);
-    ssd1306_SetCursor(5, 49);
-    ssd1306_WriteString("Menu Principal", Font_7x10, Black);
-    ssd1306_DrawBitmap(1, pos_y, bitmap_item_sel_outline, 128, 19, Black);
-    ssd1306_UpdateScreen();
+static UI_Widget_t mic_widgets[] = {
+    { .type = UI_LABEL, .x = 5, .y = 5,  .color = Black, .text = "Teste Mic", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 27, .color = Black, .text = "Mic Matriz", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 49, .color = Black, .text = "Menu Principal", .font = &Font_7x10 },
+    { .type = UI_HIGHLIGHT, .x = 1, .y = 23, .color = Black, .bitmap = &bitmap_item_sel_outline_pages },
+};
+static UI_Screen_t mic_menu = UI_SCREEN(mic_widgets, White);
+
+static void mic_update_menu(bool full) {
+    submenu_update(&mic_menu, posicao_selecao_mic, full);
 }
 
 /*
@@ -408,10 +382,14 @@ static void mic_update_menu(void) {
 void mic_home(void) {
     adc_select_input(0);
     bool can_move = true;
-    mic_update_menu();
+    mic_update_menu(true);
     while(1) {
         uint32_t adc_val = adc_read();
         uint8_t prev = posicao_selecao_mic;
+        // Qualquer movimento acorda o display; o que o acordou não move a seleção
+        if (idle_joystick(adc_val)) {
+            can_move = false;
+        }
         // Atualiza a seleção com base na leitura do ADC
         if(adc_val > 3800 && can_move) {
             posicao_selecao_mic = (posicao_selecao_mic == JOYSTICK_POS) ? MENU : posicao_selecao_mic - 1;
@@ -423,10 +401,10 @@ void mic_home(void) {
             can_move = true;
         }
         if(prev != posicao_selecao_mic)
-            mic_update_menu();
+            mic_update_menu(false);
         
         // Se o botão for pressionado, executa a ação selecionada
-        if(gpio_get(JOYSTICK_BUTTON) == 0) {
+        if(idle_button()) {
             DEBOUNCE;
             if(posicao_selecao_mic == MENU) {
                 home(4);
@@ -450,7 +428,7 @@ void mic_home(void) {
  * Inicializa e exibe o menu do microfone.
  */
 void mic_screen(void) {
-    mic_update_menu();
+    mic_update_menu(true);
     mic_home();
 }
 
@@ -469,30 +447,16 @@ void demo_display(void) {
  * Atualiza a tela do menu do display, exibindo as opções "Teste Display",
  * "Animation Display" e "Menu Principal", com o destaque posicionado conforme a seleção.
  */
-static void display_update_menu(void) {
-    uint8_t pos_y;
-    switch(posicao_selecao_display) {
-        case JOYSTICK_POS:
-            pos_y = 1;
-            break;
-        case JOYSTICK_RGB:
-            pos_y = 23;
-            break;
-        case MENU:
-            pos_y = 45;
-            break;
-        default:
-            pos_y = 23;
-    }
-    ssd1306_Fill(White);
-    ssd1306_SetCursor(5, 5);
-    ssd1306_WriteString("Teste Display", Font_7x10, Black);
-    ssd1306_SetCursor(5, 27);
-    ssd1306_WriteString("Animation Display", Font_7x10, Black);
-    ssd1306_SetCursor(5, 49);
-    ssd1306_WriteString("Menu Principal", Font_7x10, Black);
-    ssd1306_DrawBitmap(1, pos_y, bitmap_item_sel_outline, 128, 19, Black);
-    ssd1306_UpdateScreen();
+static UI_Widget_t display_widgets[] = {
+    { .type = UI_LABEL, .x = 5, .y = 5,  .color = Black, .text = "Teste Display", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 27, .color = Black, .text = "Animation Display", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 49, .color = Black, .text = "Menu Principal", .font = &Font_7x10 },
+    { .type = UI_HIGHLIGHT, .x = 1, .y = 23, .color = Black, .bitmap = &bitmap_item_sel_outline_pages },
+};
+static UI_Screen_t display_menu = UI_SCREEN(display_widgets, White);
+
+static void display_update_menu(bool full) {
+    submenu_update(&display_menu, posicao_selecao_display, full);
 }
 
 /*
@@ -504,10 +468,14 @@ static void display_update_menu(void) {
 void display_home(void) {
     adc_select_input(0);
     bool can_move = true;
-    display_update_menu();
+    display_update_menu(true);
     while(1) {
         uint32_t adc_val = adc_read();
         uint8_t prev = posicao_selecao_display;
+        // Qualquer movimento acorda o display; o que o acordou não move a seleção
+        if (idle_joystick(adc_val)) {
+            can_move = false;
+        }
         // Atualiza a seleção conforme o valor do ADC
         if(adc_val > 3800 && can_move) {
             posicao_selecao_display = (posicao_selecao_display == JOYSTICK_POS) ? MENU : posicao_selecao_display - 1;
@@ -519,10 +487,10 @@ void display_home(void) {
             can_move = true;
         }
         if(prev != posicao_selecao_display)
-            display_update_menu();
+            display_update_menu(false);
 
         // Se o botão for pressionado, executa a ação da opção selecionada
-        if(gpio_get(JOYSTICK_BUTTON) == 0) {
+        if(idle_button()) {
             DEBOUNCE;
             if(posicao_selecao_display == MENU) {
                 home(5);
@@ -546,7 +514,7 @@ void display_home(void) {
  * Inicializa e exibe o menu do display.
  */
 void display_screen(void) {
-    display_update_menu();
+    display_update_menu(true);
     display_home();
 }
 
@@ -565,30 +533,16 @@ void demo_wifi(void) {
  * Atualiza a tela do menu do wifi, exibindo as opções "Wifi Status",
  * "WebServer Status" e "Menu Principal", com destaque conforme a seleção.
  */
-static void wifi_update_menu(void) {
-    uint8_t pos_y;
-    switch(posicao_selecao_wifi) {
-        case JOYSTICK_POS:
-            pos_y = 1;
-            break;
-        case JOYSTICK_RGB:
-            pos_y = 23;
-            break;
-        case MENU:
-            pos_y = 45;
-            break;
-        default:
-            pos_y = 23;
-    }
-    ssd1306_Fill(White);
-    ssd1306_SetCursor(5, 5);
-    ssd1306_WriteString("Wifi Status", Font_7x10, Black);
-    ssd1306_SetCursor(5, 27);
-    ssd1306_WriteString("WebServer Status", Font_7x10, Black);
-    ssd1306_SetCursor(5, 49);
-    ssd1306_WriteString("Menu Principal", Font_7x10, Black);
-    ssd1306_DrawBitmap(1, pos_y, bitmap_item_sel_outline, 128, 19, Black);
-    ssd1306_UpdateScreen();
+static UI_Widget_t wifi_widgets[] = {
+    { .type = UI_LABEL, .x = 5, .y = 5,  .color = Black, .text = "Wifi Status", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 27, .color = Black, .text = "WebServer Status", .font = &Font_7x10 },
+    { .type = UI_LABEL, .x = 5, .y = 49, .color = Black, .text = "Menu Principal", .font = &Font_7x10 },
+    { .type = UI_HIGHLIGHT, .x = 1, .y = 23, .color = Black, .bitmap = &bitmap_item_sel_outline_pages },
+};
+static UI_Screen_t wifi_menu = UI_SCREEN(wifi_widgets, White);
+
+static void wifi_update_menu(bool full) {
+    submenu_update(&wifi_menu, posicao_selecao_wifi, full);
 }
 
 /*
@@ -600,10 +554,14 @@ static void wifi_update_menu(void) {
 void wifi_home(void) {
     adc_select_input(0);
     bool can_move = true;
-    wifi_update_menu();
+    wifi_update_menu(true);
     while(1) {
         uint32_t adc_val = adc_read();
         uint8_t prev = posicao_selecao_wifi;
+        // Qualquer movimento acorda o display; o que o acordou não move a seleção
+        if (idle_joystick(adc_val)) {
+            can_move = false;
+        }
         // Ajusta a seleção conforme o valor do ADC
         if(adc_val > 3800 && can_move) {
             posicao_selecao_wifi = (posicao_selecao_wifi == JOYSTICK_POS) ? MENU : posicao_selecao_wifi - 1;
@@ -615,10 +573,10 @@ void wifi_home(void) {
             can_move = true;
         }
         if(prev != posicao_selecao_wifi)
-            wifi_update_menu();
+            wifi_update_menu(false);
 
         // Se o botão for pressionado, executa a ação da opção selecionada
-        if(gpio_get(JOYSTICK_BUTTON) == 0) {
+        if(idle_button()) {
             DEBOUNCE;
             if(posicao_selecao_wifi == MENU) {
                 home(6);
@@ -642,7 +600,7 @@ void wifi_home(void) {
  * Inicializa e exibe o menu do wifi.
  */
 void wifi_screen(void) {
-    wifi_update_menu();
+    wifi_update_menu(true);
     wifi_home();
 }
 
@@ -655,7 +613,7 @@ void wifi_screen(void) {
  * o botão para selecionar uma opção, que chama a função correspondente.
  */
 void home(uint8_t option) {
-    updateHomeScreen(option);
+    updateHomeScreen(option, true);
     adc_init();
     adc_gpio_init(ADC_PIN);
     adc_select_input(1);
@@ -668,13 +626,20 @@ void home(uint8_t option) {
     while(1) 
     {
         adc_val_x = adc_read();
+        // Com o display desligado o movimento só o acorda: a opção muda no próximo
+        if (idle_joystick(adc_val_x)) {
+            while (adc_val_x < JOYSTICK_LEFT_THRESHOLD || adc_val_x > JOYSTICK_RIGHT_THRESHOLD) {
+                sleep_ms(10);
+                adc_val_x = adc_read();
+            }
+        }
         // Verifica o movimento para a esquerda (valor baixo) para selecionar a opção anterior
         if (adc_val_x < JOYSTICK_LEFT_THRESHOLD) {
             if (currentOption == 1)
                 currentOption = TOTAL_OPTIONS;
             else
                 currentOption--;
-            updateHomeScreen(currentOption);
+            updateHomeScreen(currentOption, false);
             while (adc_read() < JOYSTICK_LEFT_THRESHOLD)
                 sleep_ms(10);
             DEBOUNCE;
@@ -684,14 +649,14 @@ void home(uint8_t option) {
             currentOption++;
             if (currentOption > TOTAL_OPTIONS)
                 currentOption = 1;
-            updateHomeScreen(currentOption);
+            updateHomeScreen(currentOption, false);
             while (adc_read() > JOYSTICK_RIGHT_THRESHOLD)
                 sleep_ms(10);
             DEBOUNCE;
         }
         
         // Ao pressionar o botão, chama a função correspondente à opção selecionada
-        if (gpio_get(JOYSTICK_BUTTON) == 0) {
+        if (idle_button()) {
             DEBOUNCE;
             switch(currentOption) {
                 case 1:
@@ -716,12 +681,68 @@ void home(uint8_t option) {
                     break;
             }
             // Após retornar do demo, atualiza novamente a tela do menu principal
-            updateHomeScreen(currentOption);
+            updateHomeScreen(currentOption, true);
         }
+        idle_poll();
         sleep_ms(50);
     }
 }
 
+/*
+ * Função: idle_joystick
+ * ----------------------
+ * Qualquer leitura do joystick fora do centro conta como atividade do display,
+ * mude ela a seleção ou não. Retorna true se a leitura só acordou o display
+ * (ele estava desligado): nesse caso o chamador não deve agir sobre ela.
+ */
+bool idle_joystick(uint16_t adc_val) {
+    if (adc_val >= JOYSTICK_LEFT_THRESHOLD && adc_val <= JOYSTICK_RIGHT_THRESHOLD) {
+        return false;
+    }
+    const bool asleep = (ssd1306_GetIdleState() == SSD1306_IDLE_ASLEEP);
+    ssd1306_IdleKick();
+    return asleep;
+}
+
+/*
+ * Função: idle_button
+ * --------------------
+ * Retorna true se o botão do joystick está pressionado como comando. O aperto
+ * conta como atividade do display; com o display desligado ele só acorda o
+ * display: a função espera o botão ser solto e retorna false.
+ */
+bool idle_button(void) {
+    if (gpio_get(JOYSTICK_BUTTON) != 0) {
+        return false;
+    }
+    const bool asleep = (ssd1306_GetIdleState() == SSD1306_IDLE_ASLEEP);
+    ssd1306_IdleKick();
+    if (asleep) {
+        while (gpio_get(JOYSTICK_BUTTON) == 0) {
+            sleep_ms(10);
+        }
+        DEBOUNCE;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Função: idle_poll
+ * ------------------
+ * Tarefas de fundo dos laços de espera: o botão do joystick pressionado acorda
+ * o display, o gerenciador de inatividade do display avança (escurece e depois
+ * desliga) e a barra de status alterada pelo núcleo do Wi-Fi é enviada.
+ * Um aperto que acorda o display é consumido aqui, para a tela que chamou não
+ * tratá-lo como comando. Os movimentos do joystick acordam o display em
+ * idle_joystick.
+ */
+void idle_poll(void) {
+    idle_button();
+    ssd1306_IdleTick();
+    ssd1306_OverlayFlush();
+}
+
 // Variável global para armazenar o canal atual do ADC
 static uint8_t current_adc_channel = 1;
 
@@ -53,10 +53,17 @@ void mic_test(void)
     ssd1306_SetCursor(32, HEADER_Y);
     ssd1306_WriteString("Teste Mic", Font_7x10, Black);
 
-    ssd1306_UpdateScreen();
+    ssd1306_UpdateScreenAsync();
+
+    // Amostragem e redesenho a 20 fps
+    FRAME_Scheduler_t fs;
+    frame_Init(&fs, 20, 0);
 
     while (1)
     {
+        frame_Begin(&fs);
+        idle_poll();
+
         // Captura uma amostra do microfone
         sample_mic();
         float power = mic_power();
@@ -74,15 +81,18 @@ void mic_test(void)
         ssd1306_SetCursor(RECT_X + 5, RECT_Y + (RECT_HEIGHT / 2) - 5);
         ssd1306_WriteString(micState, Font_7x10, Black);
 
-        ssd1306_UpdateScreen();
+        ssd1306_UpdateScreenAsync();
 
         // Se o pino 22 indicar saída (por exemplo, botão pressionado), sai da função
-        if (gpio_get(22) == 0)
+        if (idle_button())
         {
             DEBOUNCE;  // Certifique-se de que o debouncing esteja implementado
+            frame_PrintStats(&fs, "mic");
             mic_home();
             break;
         }
+
+        frame_End(&fs);
     }
 }
 
@@ -0,0 +1,283 @@
+#include "inc/ui.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(SSD1306_USE_HOST)
+#include <time.h>
+
+// Relógio do host no lugar do time_us_32 do Pico SDK
+static uint32_t time_us_32(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint32_t)(ts.tv_sec * 1000000u + ts.tv_nsec / 1000);
+}
+#endif
+
+static UI_FrameStats_t UI_Stats;
+
+/**
+ * @brief Largura em pixels de um texto na fonte indicada.
+ *
+ */
+static uint16_t ui_TextWidth(const char *text, const SSD1306_Font_t *font) {
+    uint16_t width = 0;
+    for (; *text; text++) {
+        if (*text >= 32 && *text <= 126) {
+            width += font->char_width ? font->char_width[*text - 32] : font->width;
+        }
+    }
+    return width;
+}
+
+/* Retângulo vazio: widget sem largura/altura ou fora da tela */
+static const UI_Rect_t UI_EMPTY = { 1, 1, 0, 0 };
+
+static bool ui_Empty(const UI_Rect_t *r) {
+    return r->x1 > r->x2 || r->y1 > r->y2;
+}
+
+/**
+ * @brief Caixa ocupada pelo widget na tela, já recortada pelas bordas do display.
+ *
+ * Usa o tamanho do display atual (ssd1306_GetWidth/GetHeight, que já levam em
+ * conta a rotação). Widget com largura ou altura 0, ou fora da tela, tem caixa
+ * vazia.
+ */
+static UI_Rect_t ui_WidgetBox(const UI_Widget_t *widget) {
+    const uint16_t width = ssd1306_GetWidth(), height = ssd1306_GetHeight();
+    uint16_t w = widget->w, h = widget->h;
+    UI_Rect_t r;
+
+    if (widget->type == UI_LABEL) {
+        w = ui_TextWidth(widget->text, widget->font);
+        h = widget->font->height;
+    } else if (widget->type == UI_HIGHLIGHT) {
+        w = widget->bitmap->width;
+        h = widget->bitmap->height;
+    }
+
+    if (w == 0 || h == 0 || widget->x >= width || widget->y >= height) {
+        return UI_EMPTY;
+    }
+    r.x1 = widget->x;
+    r.y1 = widget->y;
+    r.x2 = (widget->x + w - 1 < width) ? widget->x + w - 1 : width - 1;
+    r.y2 = (widget->y + h - 1 < height) ? widget->y + h - 1 : height - 1;
+    return r;
+}
+
+static bool ui_Overlaps(const UI_Rect_t *a, const UI_Rect_t *b) {
+    return !ui_Empty(a) && !ui_Empty(b) && a->x1 <= b->x2 && b->x1 <= a->x2 && a->y1 <= b->y2 && b->y1 <= a->y2;
+}
+
+/**
+ * @brief Verifica se o widget desenha algum pixel dentro de r.
+ *
+ * Para o contorno (UI_BOX) só as bordas contam: um campo dentro da caixa pode
+ * mudar sem que a caixa inteira precise ser redesenhada e reenviada.
+ */
+static bool ui_Touches(const UI_Widget_t *widget, const UI_Rect_t *r) {
+    const UI_Rect_t box = ui_WidgetBox(widget);
+
+    if (!ui_Overlaps(&box, r)) {
+        return false;
+    }
+    if (widget->type == UI_BOX) {
+        return r->x1 <= box.x1 || r->x2 >= box.x2 || r->y1 <= box.y1 || r->y2 >= box.y2;
+    }
+    return true;
+}
+
+/**
+ * @brief Desenha um widget inteiro no buffer da tela.
+ *
+ */
+static void ui_Draw(const UI_Widget_t *widget) {
+    const UI_Rect_t box = ui_WidgetBox(widget);
+
+    if (ui_Empty(&box)) {
+        return;
+    }
+    switch (widget->type) {
+        case UI_LABEL:
+            ssd1306_SetCursor(widget->x, widget->y);
+            ssd1306_WriteString((char*)widget->text, *widget->font, widget->color);
+            break;
+        case UI_VALUE: {
+            const uint16_t text_width = ui_TextWidth(widget->text, widget->font);
+            const uint8_t x = (text_width < widget->w) ? widget->x + (widget->w - text_width) / 2 : widget->x;
+            const uint8_t y = (widget->font->height < widget->h) ? widget->y + (widget->h - widget->font->height) / 2 : widget->y;
+            ssd1306_SetCursor(x, y);
+            ssd1306_WriteString((char*)widget->text, *widget->font, widget->color);
+            break;
+        }
+        case UI_BOX:
+            ssd1306_DrawRectangle(box.x1, box.y1, box.x2, box.y2, widget->color);
+            break;
+        case UI_FILL:
+            ssd1306_FillRectangle(box.x1, box.y1, box.x2, box.y2, widget->color);
+            break;
+        case UI_ARROW_LEFT:
+            drawFilledTriangle(box.x1, (box.y1 + box.y2) / 2, box.x2, box.y1, box.x2, box.y2, widget->color);
+            break;
+        case UI_ARROW_RIGHT:
+            drawFilledTriangle(box.x2, (box.y1 + box.y2) / 2, box.x1, box.y1, box.x1, box.y2, widget->color);
+            break;
+        case UI_HIGHLIGHT:
+            ssd1306_BlitBitmap(widget->x, widget->y, widget->bitmap,
+                               (widget->color == Black) ? SSD1306_BLIT_ANDNOT : SSD1306_BLIT_OR);
+            break;
+    }
+}
+
+/**
+ * @brief Adiciona uma região alterada à tela, unindo-a a uma região que ela encoste.
+ *
+ */
+static void ui_AddDamage(UI_Screen_t *screen, UI_Rect_t r) {
+    if (ui_Empty(&r)) {
+        return;
+    }
+    for (uint8_t i = 0; i < screen->damage_count; i++) {
+        UI_Rect_t *d = &screen->damage[i];
+        if (ui_Overlaps(d, &r) || i + 1 == UI_MAX_DAMAGE) {
+            d->x1 = (r.x1 < d->x1) ? r.x1 : d->x1;
+            d->y1 = (r.y1 < d->y1) ? r.y1 : d->y1;
+            d->x2 = (r.x2 > d->x2) ? r.x2 : d->x2;
+            d->y2 = (r.y2 > d->y2) ? r.y2 : d->y2;
+            return;
+        }
+    }
+    screen->damage[screen->damage_count++] = r;
+}
+
+/**
+ * @brief Envia o buffer e guarda/imprime o custo do frame.
+ *
+ */
+static void ui_Flush(const char *what, uint32_t start, uint8_t widgets) {
+    ssd1306_UpdateScreenAsync();
+
+    UI_Stats.render_us = time_us_32() - start;
+    UI_Stats.bytes = ssd1306_GetFlushStats()->last_sent;
+    UI_Stats.widgets = widgets;
+#if UI_PRINT_STATS
+    printf("ui: %s %u widgets, %lu us, %lu bytes\n", what, UI_Stats.widgets,
+           (unsigned long)UI_Stats.render_us, (unsigned long)UI_Stats.bytes);
+#else
+    (void)what;
+#endif
+}
+
+/**
+ * @brief Desenha a tela inteira do zero e a envia ao display.
+ *
+ * Usada ao entrar numa tela, quando o conteúdo anterior do display é de outra tela.
+ */
+void ui_Show(UI_Screen_t *screen) {
+    const uint32_t start = time_us_32();
+
+    ssd1306_Fill(screen->background);
+    for (uint8_t i = 0; i < screen->count; i++) {
+        ui_Draw(&screen->widgets[i]);
+        screen->widgets[i].dirty = false;
+    }
+    screen->damage_count = 0;
+    ui_Flush("show", start, screen->count);
+}
+
+/**
+ * @brief Redesenha só as regiões alteradas desde o último render e envia o resultado.
+ *
+ * Cada região é apagada com a cor de fundo e os widgets que desenham nela são
+ * redesenhados na ordem da tabela. Um widget redesenhado inteiro pode passar da
+ * região, então os widgets posteriores que o sobrepõem também são redesenhados,
+ * e os pixels fora das regiões ficam exatamente como estavam. Sem alterações
+ * nada é enviado.
+ */
+void ui_Render(UI_Screen_t *screen) {
+    const uint32_t start = time_us_32();
+    uint32_t redraw = 0;    // Bit i = widget i redesenhado (no máximo 32 por tela)
+    uint8_t redrawn = 0;
+
+    for (uint8_t i = 0; i < screen->count; i++) {
+        if (screen->widgets[i].dirty) {
+            ui_AddDamage(screen, ui_WidgetBox(&screen->widgets[i]));
+            screen->widgets[i].dirty = false;
+        }
+    }
+    if (screen->damage_count == 0) {
+        return;
+    }
+
+    for (uint8_t d = 0; d < screen->damage_count; d++) {
+        const UI_Rect_t *r = &screen->damage[d];
+        ssd1306_FillRectangle(r->x1, r->y1, r->x2, r->y2, screen->background);
+    }
+
+    for (uint8_t i = 0; i < screen->count && i < 32; i++) {
+        bool touched = false;
+        for (uint8_t d = 0; d < screen->damage_count && !touched; d++) {
+            touched = ui_Touches(&screen->widgets[i], &screen->damage[d]);
+        }
+        for (uint8_t j = 0; j < i && !touched; j++) {
+            if (redraw & (1u << j)) {
+                const UI_Rect_t box = ui_WidgetBox(&screen->widgets[j]);
+                touched = ui_Touches(&screen->widgets[i], &box);
+            }
+        }
+        if (touched) {
+            ui_Draw(&screen->widgets[i]);
+            redraw |= 1u << i;
+            redrawn++;
+        }
+    }
+
+    screen->damage_count = 0;
+    ui_Flush("render", start, redrawn);
+}
+
+/**
+ * @brief Marca o widget para ser redesenhado no próximo ui_Render.
+ *
+ */
+void ui_Invalidate(UI_Screen_t *screen, UI_Widget_t *widget) {
+    ui_AddDamage(screen, ui_WidgetBox(widget));
+}
+
+/**
+ * @brief Troca o texto de um UI_LABEL ou UI_VALUE.
+ *
+ * A caixa antiga entra como região alterada (o texto novo pode ser menor).
+ */
+void ui_SetText(UI_Screen_t *screen, UI_Widget_t *widget, const char *text) {
+    if (widget->text == text || (widget->text && text && strcmp(widget->text, text) == 0)) {
+        widget->text = text;
+        return;
+    }
+    ui_AddDamage(screen, ui_WidgetBox(widget));
+    widget->text = text;
+    widget->dirty = true;
+}
+
+/**
+ * @brief Move o widget para (x, y); a posição antiga entra como região alterada.
+ *
+ */
+void ui_MoveTo(UI_Screen_t *screen, UI_Widget_t *widget, uint8_t x, uint8_t y) {
+    if (widget->x == x && widget->y == y) {
+        return;
+    }
+    ui_AddDamage(screen, ui_WidgetBox(widget));
+    widget->x = x;
+    widget->y = y;
+    widget->dirty = true;
+}
+
+/**
+ * @brief Retorna o custo (tempo e bytes) do último ui_Show/ui_Render.
+ *
+ */
+const UI_FrameStats_t* ui_GetFrameStats(void) {
+    return &UI_Stats;
+}
@@ -1,717 +1,504 @@
 #include "inc/wifi.h"
-
-// Buffer para resposta HTTP
-char http_response[8192];
+#include "inc/webpages.h"
+#include "inc/http.h"
 
 //Armazena o SSID da rede WI-FI conectada
 char wifi_ssid[64] = "";
 
 // Variáveis globais adicionais (adicionar no início do arquivo)
 uint32_t last_cloud_update = 0;
+uint32_t last_cloud_upload_ms = 0;  // Instante (ms desde o boot) do último envio; 0 = nenhum
+
+// Barra de status na sobreposição do display: colunas dos ícones e tempo
+// que o ícone de envio fica aceso depois de cada envio para a nuvem
+#define STATUS_WIFI_X       120
+#define STATUS_CLOUD_X      111
+#define STATUS_UPLOAD_MS    2000
 
 // Timer para requisições periódicas
 static repeating_timer_t request_timer;
 volatile bool request_pending = false; // Flag atômico
 
+// Espelho da tela do display: linhas de 1 bit por pixel
+#define SCREEN_ROW_BYTES    (SSD1306_WIDTH / 8)
+#define SCREEN_BMP_HEADER   62
+
 /**
- * @brief Cria a resposta HTTP para a página principal.
- * 
- * Esta função gera o HTML da página inicial do servidor HTTP, que contém opções
- * para interagir com diferentes componentes da placa BitDogLab.
+ * @brief Lê o número de frame que o cliente já tem (?since=N ou If-None-Match).
+ *
+ * @return true se a requisição trouxe um número de frame.
  */
-void create_http_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>PicoEdu: Aprendizado Dinâmico</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0, 0, 0, 0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.2em;"
-        "      color: #666;"
-        "      margin-bottom: 30px;"
-        "    }"
-        "    .btn {"
-        "      display: inline-block;"
-        "      margin: 10px;"
-        "      padding: 15px 25px;"
-        "      font-size: 1em;"
-        "      font-weight: 500;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border: none;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    .btn:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>PicoEdu: Aprendizado Dinâmico</h1>"
-        "    <p>Explore as opções abaixo para iniciar seu aprendizado com a placa BitDogLab.</p>"
-        "    <a class=\"btn\" href=\"/option/joystick\">Joystick</a>"
-        "    <a class=\"btn\" href=\"/option/matriz\">Matriz</a>"
-        "    <a class=\"btn\" href=\"/option/buzzer\">Buzzer</a>"
-        "    <a class=\"btn\" href=\"/option/mic\">Mic</a>"
-        "    <a class=\"btn\" href=\"/option/display\">Display</a>"
-        "    <a class=\"btn\" href=\"/option/wifi\">Wifi</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
-}
-
+static bool screen_client_seq(const HTTP_Request_t *request, uint32_t *seq)
+{
+    const char *tag = http_QueryValue(request, "since");
+    if (tag == NULL) {
+        tag = request->if_none_match;
+        if (tag[0] == 'W' && tag[1] == '/') {
+            tag += 2;
+        }
+        if (*tag == '"') {
+            tag++;
+        }
+    }
 
+    if (*tag < '0' || *tag > '9') {
+        return false;
+    }
+    *seq = (uint32_t)strtoul(tag, NULL, 10);
+    return true;
+}
 
 /**
- * @brief Cria a resposta HTTP para a página do Joystick.
- * 
- * Esta função gera o HTML da página que explica o funcionamento do joystick
- * e como ele é integrado à placa BitDogLab.
+ * @brief Escreve n bytes de valor em little-endian (cabeçalho do BMP).
+ *
  */
-void create_joystick_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>Joystick - PicoEdu</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0, 0, 0, 0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.1em;"
-        "      color: #555;"
-        "      margin: 15px 0;"
-        "      text-align: justify;"
-        "      line-height: 1.6;"
-        "    }"
-        "    a {"
-        "      display: inline-block;"
-        "      margin-top: 20px;"
-        "      padding: 12px 20px;"
-        "      font-size: 1em;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    a:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>Joystick</h1>"
-        "    <p> O joystick converte a posição da alavanca em sinais elétricos. No caso do modelo da BitDogLab, trata-se de um joystick analógico, no qual as posições nos eixos X e Y são convertidas em dois sinais de tensão que variam de 0 a 3,3V.</p>"
-        "    <p>Quando a alavanca está na posição neutra, os valores dessas tensões são aproximadamente iguais à metade da tensão de alimentação, ou seja, Vx = Vy = VCC/2. Ao movimentar a alavanca, esses valores variam proporcionalmente à posição do joystick.</p>"
-        "    <p>Os sinais analógicos gerados são lidos pelos conversores Analógico-Digitais (ADCs) do microcontrolador RP2040, que estão disponíveis nos pinos GPIO 26 e GPIO 27. Esses conversores transformam os valores analógicos em dados digitais, permitindo que o microcontrolador processe as informações.</p>"
-        "    <p>Além disso, o joystick possui um botão integrado, que é acionado ao pressionar a alavanca para baixo. Esse botão está conectado ao GPIO 22 do RP2040 e deve ser configurado como entrada digital com pull-up. Em repouso, ele permanece em nível lógico alto e, ao ser pressionado, muda para nível lógico baixo.</p>"
-        "    <p>Para exibir os valores lidos pelo joystick, utilizaremos o próprio terminal do VS Code como interface de saída. No terminal, serão apresentados os valores numéricos dos sinais analógicos e uma barra gráfica que se movimentará de forma proporcional à posição do joystick, facilitando a visualização do funcionamento do sensor.</p>"
-        "    <a href=\"/\">Voltar ao menu</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
+static uint8_t *screen_put_le(uint8_t *p, uint32_t value, uint8_t n)
+{
+    while (n--) {
+        *p++ = (uint8_t)value;
+        value >>= 8;
+    }
+    return p;
 }
 
 /**
- * @brief Cria a resposta HTTP para a página da Matriz de LEDs.
- * 
- * Esta função gera o HTML da página que explica o funcionamento da matriz de LEDs
- * e como ela é controlada pelo microcontrolador RP2040.
+ * @brief Monta o cabeçalho de um BMP de 1 bit (paleta 0 = preto, 1 = branco).
+ *
  */
-void create_matriz_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>Matriz - PicoEdu</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0, 0, 0, 0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    h2 {"
-        "      font-size: 1.8em;"
-        "      color: #333;"
-        "      margin: 20px 0 10px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.1em;"
-        "      color: #555;"
-        "      margin: 15px 0;"
-        "      text-align: justify;"
-        "      line-height: 1.6;"
-        "    }"
-        "    a {"
-        "      display: inline-block;"
-        "      margin-top: 20px;"
-        "      padding: 12px 20px;"
-        "      font-size: 1em;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    a:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>Matriz</h1>"
-        "    <p>Para controlar um LED RGB, são necessários três sinais individuais: um para cada cor (vermelho, verde e azul). Agora, imagine aplicar esse método a uma matriz com 25 LEDs RGB, organizados em 5 colunas por 5 linhas. Seriam necessários 75 sinais de controle (3 x 25), tornando inviável o uso direto de um microcontrolador convencional. Felizmente, os LEDs endereçáveis, como os WS2812, resolvem esse problema. Embora também sejam RGB, eles podem ser controlados usando apenas um único pino de dados digital. Os LEDs podem ser conectados em cadeia, onde a saída DOUT de um LED se conecta à entrada DIN do próximo. Dessa forma, um único pino do microcontrolador controla todos os LEDs, ajustando individualmente sua cor e intensidade.</p>"
-        "    <h2>Desafios no Controle dos LEDs</h2>"
-        "    <p>Embora essa tecnologia simplifique a conexão elétrica, o controle dos LEDs exige um timing extremamente preciso, pois o protocolo WS2812 opera com variações de tempo na ordem de nanosegundos.</p>"
-        "    <h2>Uso do PIO no RP2040 para Controle dos LEDs</h2>"
-        "    <p>No RP2040, podemos utilizar o PIO (Programmable Input/Output) para garantir que os sinais enviados aos LEDs sejam gerados com precisão, sem sobrecarregar o processador. O PIO funciona como uma máquina de estado programável capaz de operar de forma independente, permitindo a geração precisa dos sinais exigidos pelo WS2812, redução do consumo de processamento e execução de outras tarefas simultaneamente. A função npWrite utiliza o PIO para enviar os dados armazenados no buffer da matriz de LEDs para o hardware, transmitindo as cores previamente definidas enquanto o PIO cuida do envio correto dos sinais, garantindo a sincronização necessária. Essa abordagem torna o sistema mais eficiente, permitindo animações fluidas e controle preciso dos LEDs sem impactar o desempenho do microcontrolador.</p>"
-        "    <a href=\"/\">Voltar ao menu</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
+static void screen_bmp_header(uint8_t header[SCREEN_BMP_HEADER])
+{
+    const uint32_t image_size = SSD1306_HEIGHT * SCREEN_ROW_BYTES;
+    uint8_t *p = header;
+
+    // BITMAPFILEHEADER
+    *p++ = 'B';
+    *p++ = 'M';
+    p = screen_put_le(p, SCREEN_BMP_HEADER + image_size, 4);
+    p = screen_put_le(p, 0, 4);
+    p = screen_put_le(p, SCREEN_BMP_HEADER, 4);
+
+    // BITMAPINFOHEADER (altura positiva: linhas de baixo para cima)
+    p = screen_put_le(p, 40, 4);
+    p = screen_put_le(p, SSD1306_WIDTH, 4);
+    p = screen_put_le(p, SSD1306_HEIGHT, 4);
+    p = screen_put_le(p, 1, 2);
+    p = screen_put_le(p, 1, 2);
+    p = screen_put_le(p, 0, 4);
+    p = screen_put_le(p, image_size, 4);
+    p = screen_put_le(p, 2835, 4);
+    p = screen_put_le(p, 2835, 4);
+    p = screen_put_le(p, 2, 4);
+    p = screen_put_le(p, 2, 4);
+
+    // Paleta: pixel apagado preto, aceso branco, como no OLED
+    p = screen_put_le(p, 0x00000000, 4);
+    p = screen_put_le(p, 0x00FFFFFF, 4);
 }
 
+// Formatos da imagem da tela (arg de screen_image_rows)
+static const bool screen_format_bmp = true;
+static const bool screen_format_pbm = false;
 
 /**
- * @brief Cria a resposta HTTP para a página do Buzzer.
- * 
- * Esta função gera o HTML da página que explica o funcionamento do buzzer
- * e como ele é controlado pelo microcontrolador RP2040.
+ * @brief Gera as linhas da imagem da tela que couberem em buf (http_WriteStream).
+ *
+ * cursor é a próxima linha da imagem; arg diz o formato (true = BMP).
  */
-void create_buzzer_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>Buzzer - PicoEdu</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0, 0, 0, 0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    h2 {"
-        "      font-size: 1.8em;"
-        "      color: #333;"
-        "      margin: 20px 0 10px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.1em;"
-        "      color: #555;"
-        "      margin: 15px 0;"
-        "      text-align: justify;"
-        "      line-height: 1.6;"
-        "    }"
-        "    a {"
-        "      display: inline-block;"
-        "      margin-top: 20px;"
-        "      padding: 12px 20px;"
-        "      font-size: 1em;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    a:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>Buzzer</h1>"
-        "    <p><strong>Funcionamento de um Buzzer Passivo:</strong></p>"
-        "    <p>Um buzzer passivo funciona de maneira semelhante a um alto-falante básico, utilizando uma bobina eletromagnética e uma membrana vibratória para produzir som.</p>"
-        "    <p>Quando um sinal elétrico variável é aplicado à bobina, ele gera um campo magnético que interage com um ímã fixo dentro do buzzer. Essa interação faz com que a bobina e a membrana se movimentem, criando vibrações que deslocam o ar ao redor e geram ondas sonoras, as quais podem ser percebidas pelo ouvido humano.</p>"
-        "    <h2>Como a Música é Produzida com um Buzzer?</h2>"
-        "    <p>O som é uma onda mecânica que se propaga através de meios como o ar, água ou sólidos. Essas ondas são geradas por vibrações que movimentam as partículas do meio. Os principais parâmetros que determinam as características do som são: <strong>Frequência</strong> (medida em Hertz - Hz), que define se o som é mais agudo ou mais grave, e <strong>Amplitude</strong>, que determina a intensidade (volume) do som.</p>"
-        "    <h2>Controle do Buzzer Passivo</h2>"
-        "    <p>Para gerar sons com um buzzer passivo, é necessário fornecer um sinal elétrico variável, pois ele não possui um oscilador interno. A técnica mais comum para isso é a Modulação por Largura de Pulso (PWM), que permite controlar a frequência do som gerado. Dessa forma, é possível criar desde simples bipes até melodias mais complexas. Compreender os princípios matemáticos do som é essencial para utilizar o buzzer de maneira eficiente, possibilitando o controle preciso tanto da frequência quanto da amplitude do sinal.</p>"
-        "    <a href=\"/\">Voltar ao menu</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
+static uint16_t screen_image_rows(const void *arg, uint32_t *cursor, uint8_t *buf, uint16_t max)
+{
+    const bool bmp = *(const bool *)arg;
+    uint16_t len = 0;
+
+    while (*cursor < SSD1306_HEIGHT && len + SCREEN_ROW_BYTES <= max) {
+        const uint8_t row = (uint8_t)(*cursor)++;
+        // BMP guarda as linhas de baixo para cima; PBM de cima para baixo
+        const uint8_t y = bmp ? SSD1306_HEIGHT - 1 - row : row;
+        uint8_t *out = &buf[len];
+
+        ssd1306_ReadRow(y, out);
+        if (!bmp) {
+            // No PBM o bit 1 é preto
+            for (uint8_t b = 0; b < SCREEN_ROW_BYTES; b++) {
+                out[b] = (uint8_t)~out[b];
+            }
+        }
+        len += SCREEN_ROW_BYTES;
+    }
+    return len;
 }
 
-
 /**
- * @brief Cria a resposta HTTP para a página do Microfone.
- * 
- * Esta função gera o HTML da página que explica o funcionamento do microfone
- * e como ele é controlado pelo microcontrolador RP2040.
+ * @brief Envia a tela atual como imagem (BMP ou PBM) direto do framebuffer.
+ *
+ * A imagem não é montada inteira na memória: as linhas são lidas do buffer do
+ * display (já com a sobreposição) por screen_image_rows, só quando há espaço
+ * na fila de envio. O ETag é o número do frame; se o cliente já tem esse
+ * frame a resposta é um 304 sem corpo.
  */
-void create_microfone_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>Microfone - PicoEdu</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0, 0, 0, 0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    h2 {"
-        "      font-size: 1.8em;"
-        "      color: #333;"
-        "      margin: 20px 0 10px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.1em;"
-        "      color: #555;"
-        "      margin: 15px 0;"
-        "      text-align: justify;"
-        "      line-height: 1.6;"
-        "    }"
-        "    a {"
-        "      display: inline-block;"
-        "      margin-top: 20px;"
-        "      padding: 12px 20px;"
-        "      font-size: 1em;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    a:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>Microfone</h1>"
-        "    <p>Neste estudo, vamos aprender a ler sinais analógicos e processá-los com alta taxa de amostragem utilizando o recurso de DMA (Direct Memory Access), que permite a transferência de dados do Conversor Analógico-Digital (ADC) para a memória sem intervenção direta da CPU, otimizando o desempenho do sistema.</p>"
-        "    <h2>Características do Sinal de Saída do Microfone</h2>"
-        "    <p>O microfone presente na placa gera um sinal analógico cuja tensão varia conforme o som captado:<br>"
-        "       <strong>Offset:</strong> Quando não há som, a saída do microfone é 1,65V, correspondente ao centro da faixa do ADC. Esse valor pode ser ajustado com um trimpot.<br>"
-        "       <strong>Amplitude Máxima:</strong> O sinal pode oscilar até ±1,65V em relação ao offset, atingindo valores entre 0V e 3,3V, dependendo da intensidade do som.<br>"
-        "       <strong>Faixa Total do Sinal:</strong> O sinal analógico gerado varia de 0V a 3,3V, utilizando toda a faixa dinâmica do ADC, garantindo a melhor resolução e qualidade da leitura.</p>"
-        "    <h2>Características do Conversor Analógico-Digital (ADC) do RP2040</h2>"
-        "    <p>O ADC do RP2040, presente no Raspberry Pi Pico, possui as seguintes especificações:<br>"
-        "       <strong>Faixa de Medição (Range):</strong> Mede tensões entre 0V e VREF, onde VREF é fixado internamente em 3,3V.<br>"
-        "       <strong>Resolução do ADC:</strong> A conversão é realizada com 12 bits de resolução, gerando valores entre 0 (0V) e 4095 (3,3V).<br>"
-        "       <strong>Conversão para Formato Signed:</strong> Para facilitar o processamento, os valores brutos (0 a 4095) são convertidos para um intervalo centrado em 0 usando a fórmula:<br>"
-        "       Valor_signed = Valor_bruto_ADC - 2048<br>"
-        "       Assim, a saída do microfone (1,65V) corresponde ao valor 0 após a conversão.</p>"
-        "    <a href=\"/\">Voltar ao menu</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
+static void send_screen_image(HTTP_Conn_t *conn, const HTTP_Request_t *request, bool bmp)
+{
+    const uint32_t seq = ssd1306_GetFlushStats()->frame_seq;
+    uint32_t known;
+    char headers[64];
+
+    snprintf(headers, sizeof(headers), "ETag: \"%lu\"\r\nCache-Control: no-cache\r\n", (unsigned long)seq);
+    if (screen_client_seq(request, &known) && known == seq) {
+        http_Begin(conn, 304, NULL, 0, headers);
+        return;
+    }
+
+    // Cabeçalho do formato: BMP para o navegador, PBM (P4) para ferramentas
+    uint8_t prefix[SCREEN_BMP_HEADER];
+    uint16_t prefix_len;
+    if (bmp) {
+        screen_bmp_header(prefix);
+        prefix_len = SCREEN_BMP_HEADER;
+    } else {
+        prefix_len = (uint16_t)snprintf((char *)prefix, sizeof(prefix), "P4\n%d %d\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    }
+
+    http_Begin(conn, 200, bmp ? "image/bmp" : "image/x-portable-bitmap",
+               prefix_len + SSD1306_HEIGHT * SCREEN_ROW_BYTES, headers);
+    http_Write(conn, prefix, prefix_len);
+    http_WriteStream(conn, screen_image_rows, bmp ? &screen_format_bmp : &screen_format_pbm);
 }
 
+// GET /screen.bmp (e /screen): imagem da tela para o navegador
+static void route_screen_bmp(HTTP_Conn_t *conn, const HTTP_Request_t *request, const void *arg)
+{
+    send_screen_image(conn, request, true);
+}
+
+// GET /screen.pbm: imagem da tela para ferramentas
+static void route_screen_pbm(HTTP_Conn_t *conn, const HTTP_Request_t *request, const void *arg)
+{
+    send_screen_image(conn, request, false);
+}
 
 /**
- * @brief Cria a resposta HTTP para a página do Display.
- * 
- * Esta função gera o HTML da página que explica o funcionamento do Display
- * e como ele é controlado pelo microcontrolador RP2040.
+ * @brief GET /screen/seq: só o número do frame, {"seq":N}.
+ *
+ * Para a página só baixar a imagem quando a tela mudar.
  */
-void create_display_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>Display - PicoEdu</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0,0,0,0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    h2 {"
-        "      font-size: 1.8em;"
-        "      color: #333;"
-        "      margin: 20px 0 10px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.1em;"
-        "      color: #555;"
-        "      margin: 15px 0;"
-        "      text-align: justify;"
-        "      line-height: 1.6;"
-        "    }"
-        "    a {"
-        "      display: inline-block;"
-        "      margin-top: 20px;"
-        "      padding: 12px 20px;"
-        "      font-size: 1em;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    a:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>Display</h1>"
-        "    <p>Aqui você aprenderá como o Display funciona.</p>"
-        "    <p>O display OLED SSD1306 é um dispositivo de exibição digital que utiliza a tecnologia OLED (Organic Light-Emitting Diode) para apresentar informações visuais com alto contraste e baixo consumo de energia.</p>"
-        "    <p><strong>Características e Funcionamento:</strong><br>"
-        "       <strong>Tecnologia OLED:</strong> Ao contrário dos displays LCD, que dependem de uma fonte de luz de fundo, os diodos orgânicos emissores de luz geram sua própria iluminação, proporcionando imagens mais nítidas, com pretos mais profundos e maior eficiência energética.<br>"
-        "       <strong>Controlador SSD1306:</strong> Este controlador integrado gerencia o funcionamento do display, convertendo os dados enviados pelo microcontrolador em sinais elétricos que acendem os pixels correspondentes. Ele possibilita a exibição de textos, gráficos e imagens em resoluções comuns de 128×64 pixels.<br>"
-        "       <strong>Interfaces de Comunicação:</strong> O SSD1306 pode ser controlado por meio de interfaces I2C ou SPI, sendo que a interface I2C utiliza apenas dois pinos, facilitando a integração com diversos microcontroladores, como o Arduino e o Raspberry Pi Pico.</p>"
-        "    <h2>Aplicações e Utilização</h2>"
-        "    <p>Para utilizar o display OLED SSD1306, é necessário estabelecer uma comunicação entre o BitDog Lab e o display. Bibliotecas específicas facilitam o processo de programação, permitindo que você:<br>"
-        "       - Envie comandos para limpar ou atualizar a tela.<br>"
-        "       - Exiba textos e gráficos de forma dinâmica.<br>"
-        "       - Controle a intensidade dos pixels, garantindo uma visualização ideal em diferentes condições de iluminação.</p>"
-        "    <h2>Vantagens do SSD1306</h2>"
-        "    <p>Entre as principais vantagens do SSD1306, destacam-se:<br>"
-        "       <strong>Alto Contraste:</strong> Garante excelente legibilidade, mesmo em ambientes com muita luz.<br>"
-        "       <strong>Baixo Consumo de Energia:</strong> Ideal para dispositivos portáteis e aplicações com restrição de energia.<br>"
-        "       <strong>Versatilidade:</strong> Pode ser utilizado em uma ampla gama de projetos, desde sistemas embarcados simples até interfaces gráficas mais complexas.</p>"
-        "    <a href=\"/\">Voltar ao menu</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
+static void route_screen_seq(HTTP_Conn_t *conn, const HTTP_Request_t *request, const void *arg)
+{
+    char body[32];
+    const int body_len = snprintf(body, sizeof(body), "{\"seq\":%lu}",
+                                  (unsigned long)ssd1306_GetFlushStats()->frame_seq);
+
+    http_Begin(conn, 200, "application/json", body_len, "Cache-Control: no-store\r\n");
+    http_Write(conn, body, (uint16_t)body_len);
 }
 
+// Transmissão da tela por Server-Sent Events (GET /screen/stream)
+#ifndef SCREEN_STREAM_CLIENTS
+#define SCREEN_STREAM_CLIENTS       2       // Navegadores acompanhando a tela ao mesmo tempo
+#endif
+#ifndef SCREEN_STREAM_MIN_MS
+#define SCREEN_STREAM_MIN_MS        100     // Intervalo mínimo entre dois eventos do mesmo cliente
+#endif
+#ifndef SCREEN_STREAM_KEEPALIVE_MS
+#define SCREEN_STREAM_KEEPALIVE_MS  15000   // Comentário SSE enviado quando a tela fica parada
+#endif
+
+#define SCREEN_PAGES                (SSD1306_HEIGHT / 8)
+#define SCREEN_SPAN_HEADER          3       // página, coluna, quantidade
+// Com trechos separados por pelo menos SCREEN_SPAN_HEADER + 1 colunas iguais,
+// uma página nunca passa de SSD1306_WIDTH + SCREEN_SPAN_HEADER bytes
+#define SCREEN_DELTA_MAX            (SCREEN_PAGES * (SSD1306_WIDTH + SCREEN_SPAN_HEADER))
+#define SCREEN_EVENT_MAX            (32 + 4 * ((SCREEN_DELTA_MAX + 2) / 3))
+
+/* Cliente da transmissão: a cópia do que ele já recebeu serve de base ao próximo delta */
+typedef struct {
+    struct tcp_pcb *pcb;            // NULL = posição livre
+    bool synced;                    // shadow válido (já recebeu a tela inteira)
+    uint32_t inflight;              // Bytes enviados e ainda sem ACK
+    uint32_t last_ms;               // Instante do último evento
+    uint8_t shadow[SSD1306_BUFFER_SIZE];
+} WIFI_ScreenClient_t;
+
+static WIFI_ScreenClient_t screen_clients[SCREEN_STREAM_CLIENTS];
+static uint8_t screen_frame[SSD1306_BUFFER_SIZE];   // Última tela completa lida do display
+static uint32_t screen_frame_seq;
+static bool screen_frame_valid = false;
+
 /**
- * @brief Cria a resposta HTTP para a página do WIFI.
- * 
- * Esta função gera o HTML da página que explica o funcionamento do WIFI
- * e como ele é controlado pelo microcontrolador RP2040.
+ * @brief Codifica len bytes em base64 (sem terminador).
+ *
+ * @return Quantidade de caracteres escritos em out.
  */
-void create_wifi_response(void) {
-    snprintf(http_response, sizeof(http_response),
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n"
-        "<!DOCTYPE html>"
-        "<html lang=\"pt\">"
-        "<head>"
-        "  <meta charset=\"UTF-8\">"
-        "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">"
-        "  <title>Wifi - PicoEdu</title>"
-        "  <link href=\"https://fonts.googleapis.com/css?family=Roboto:300,400,500&display=swap\" rel=\"stylesheet\">"
-        "  <style>"
-        "    body {"
-        "      margin: 0;"
-        "      padding: 0;"
-        "      font-family: 'Roboto', sans-serif;"
-        "      background: linear-gradient(135deg, #74ebd5, #ACB6E5);"
-        "      min-height: 100vh;"
-        "      display: flex;"
-        "      align-items: center;"
-        "      justify-content: center;"
-        "    }"
-        "    .container {"
-        "      width: 90%%;"
-        "      max-width: 800px;"
-        "      background: #fff;"
-        "      border-radius: 12px;"
-        "      padding: 40px;"
-        "      box-shadow: 0 8px 16px rgba(0,0,0,0.2);"
-        "      text-align: center;"
-        "    }"
-        "    h1 {"
-        "      font-size: 2.5em;"
-        "      color: #333;"
-        "      margin-bottom: 20px;"
-        "    }"
-        "    p {"
-        "      font-size: 1.1em;"
-        "      color: #555;"
-        "      margin: 15px 0;"
-        "      text-align: justify;"
-        "      line-height: 1.6;"
-        "    }"
-        "    .text-link {"
-        "      color: #1a73e8;"
-        "      text-decoration: none;"
-        "      font-weight: bold;"
-        "    }"
-        "    .text-link:hover {"
-        "      text-decoration: underline;"
-        "    }"
-        "    .button {"
-        "      display: inline-block;"
-        "      margin-top: 20px;"
-        "      padding: 12px 20px;"
-        "      font-size: 1em;"
-        "      text-decoration: none;"
-        "      color: #fff;"
-        "      background-color: #5c6bc0;"
-        "      border-radius: 8px;"
-        "      transition: background-color 0.3s ease, transform 0.3s ease;"
-        "    }"
-        "    .button:hover {"
-        "      background-color: #3f51b5;"
-        "      transform: translateY(-3px);"
-        "    }"
-        "  </style>"
-        "</head>"
-        "<body>"
-        "  <div class=\"container\">"
-        "    <h1>Wifi</h1>"
-        "    <p>Aqui você aprenderá como o wifi funciona.</p>"
-        "    <p>A Raspberry Pi Pico W possui suporte à conectividade Wi-Fi, permitindo a implementação de funcionalidades avançadas, como a criação de servidores HTTP. Utilizando a linguagem C e o SDK oficial da Raspberry Pi, é possível desenvolver aplicações que interagem diretamente com dispositivos como smartphones e computadores por meio de redes Wi-Fi. Na placa que você tem em mãos, a Pico W está conectada a uma rede Wi-Fi e configurada como um servidor HTTP básico. Esse servidor possibilita que esse site que você está vendo exista. Além disso, configurando a BitDog Lab como cliente HTTP, é possível a troca de informações entre a Pico W e outros dispositivos, viabilizando aplicações como controle remoto, monitoramento de sensores e automação. Com essa abordagem, a Pico W pode atuar como um ponto de acesso para receber comandos e exibir informações, tornando-se uma ferramenta versátil para diversos projetos conectados.</p>"
-        "    <p>Nesse Link: <a class=\"text-link\" href=\"https://thingspeak.mathworks.com/channels/2838406\" target=\"_blank\">ThingSpeak</a> temos um exemplo de uma aplicação com a nuvem onde um código simples manda a temperatura para um banco de dados na nuvem, onde a partir disso diversas aplicações podem ser feitas.</p>"
-        "    <a href=\"/\" class=\"button\">Voltar ao menu</a>"
-        "  </div>"
-        "</body>"
-        "</html>\r\n");
+static uint16_t screen_base64(const uint8_t *in, uint16_t len, char *out)
+{
+    static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char *start = out;
+
+    for (uint16_t i = 0; i < len; i += 3) {
+        const uint32_t n = ((uint32_t)in[i] << 16)
+                         | ((i + 1 < len) ? (uint32_t)in[i + 1] << 8 : 0)
+                         | ((i + 2 < len) ? in[i + 2] : 0);
+        *out++ = digits[(n >> 18) & 0x3F];
+        *out++ = digits[(n >> 12) & 0x3F];
+        *out++ = (i + 1 < len) ? digits[(n >> 6) & 0x3F] : '=';
+        *out++ = (i + 2 < len) ? digits[n & 0x3F] : '=';
+    }
+    return (uint16_t)(out - start);
 }
 
+/**
+ * @brief Monta os trechos que mudaram entre shadow e a tela atual.
+ *
+ * Cada trecho é [página][coluna][n][n bytes de coluna]; trechos de uma mesma
+ * página separados por poucas colunas iguais são juntados, já que o cabeçalho
+ * custaria mais que os bytes repetidos.
+ *
+ * @return Tamanho do delta (0 = nada mudou).
+ */
+static uint16_t screen_delta(const uint8_t *shadow, bool synced, uint8_t *out)
+{
+    uint16_t len = 0;
+
+    for (uint8_t page = 0; page < SCREEN_PAGES; page++) {
+        const uint8_t *now = &screen_frame[page * SSD1306_WIDTH];
+        const uint8_t *old = &shadow[page * SSD1306_WIDTH];
+        uint8_t x = 0;
+
+        while (x < SSD1306_WIDTH) {
+            if (synced && now[x] == old[x]) {
+                x++;
+                continue;
+            }
+
+            // Estende o trecho até achar colunas iguais suficientes para valer um novo cabeçalho
+            const uint8_t start = x;
+            uint8_t end = x;
+            uint8_t same = 0;
+            while (++x < SSD1306_WIDTH && same <= SCREEN_SPAN_HEADER) {
+                if (synced && now[x] == old[x]) {
+                    same++;
+                } else {
+                    end = x;
+                    same = 0;
+                }
+            }
+            x = end + 1;
+
+            out[len++] = page;
+            out[len++] = start;
+            out[len++] = end - start + 1;
+            memcpy(&out[len], &now[start], end - start + 1);
+            len += end - start + 1;
+        }
+    }
+    return len;
+}
 
 /**
- * @brief Função de callback para processar requisições HTTP.
- * 
- * Esta função é chamada quando uma requisição HTTP é recebida pelo servidor.
- * Ela verifica o tipo de requisição (com base na URL) e gera a resposta apropriada
- * para cada caso, como a página do joystick, matriz de LEDs, buzzer, etc.
- * 
- * @param arg Argumento genérico (não utilizado).
- * @param tpcb Estrutura que representa a conexão TCP.
- * @param p Buffer contendo os dados da requisição HTTP.
- * @param err Código de erro (se houver).
- * @return err_t Retorna ERR_OK se a requisição foi processada com sucesso.
+ * @brief Libera a posição do cliente (a conexão já foi fechada ou abortada).
+ *
  */
-static err_t http_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) 
+static void screen_stream_release(WIFI_ScreenClient_t *client)
 {
+    client->pcb = NULL;
+    client->synced = false;
+}
+
+// Bytes confirmados pelo navegador: libera espaço para o próximo evento
+static err_t screen_stream_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+    WIFI_ScreenClient_t *client = (WIFI_ScreenClient_t *)arg;
+    client->inflight = (len < client->inflight) ? client->inflight - len : 0;
+    return ERR_OK;
+}
+
+// O navegador não manda nada depois da requisição; p == NULL é o fechamento
+static err_t screen_stream_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    WIFI_ScreenClient_t *client = (WIFI_ScreenClient_t *)arg;
+
     if (p == NULL) {
-        // Cliente fechou a conexão
+        screen_stream_release(client);
+        tcp_arg(tpcb, NULL);
+        tcp_sent(tpcb, NULL);
+        tcp_recv(tpcb, NULL);
+        tcp_err(tpcb, NULL);
         tcp_close(tpcb);
         return ERR_OK;
     }
+    tcp_recved(tpcb, p->tot_len);
+    pbuf_free(p);
+    return ERR_OK;
+}
 
-    // Processa a requisição HTTP
-    char *request = (char *)p->payload;
+// Conexão abortada (reset, falta de memória): o lwIP já liberou o pcb
+static void screen_stream_error(void *arg, err_t err)
+{
+    screen_stream_release((WIFI_ScreenClient_t *)arg);
+}
 
-    if(strstr(request, "GET /option/joystick") != NULL)
-    {
-        create_joystick_response();
-    } 
-    else if (strstr(request, "GET /option/matriz") != NULL) {
-        create_matriz_response();
-    } else if (strstr(request, "GET /option/buzzer") != NULL) {
-        create_buzzer_response();
-    } else if (strstr(request, "GET /option/mic") != NULL) {
-        create_microfone_response();
-    } else if (strstr(request, "GET /option/display") != NULL) {
-        create_display_response();
-    } else if (strstr(request, "GET /option/wifi") != NULL) {
-        create_wifi_response();
-    } else {
-        // Requisição padrão: mostra o menu principal
-        create_http_response();
+/**
+ * @brief Aceita um navegador na transmissão da tela (GET /screen/stream).
+ *
+ * Responde com os cabeçalhos do text/event-stream e deixa a conexão aberta; a
+ * tela inteira vai no primeiro evento, em screen_stream_poll. A conexão deixa o
+ * servidor HTTP (http_Detach) e passa a ser lida por screen_stream_recv. Sem
+ * posição livre a resposta é 503 e o navegador tenta de novo depois.
+ */
+static void screen_stream_open(HTTP_Conn_t *conn)
+{
+    static const char header[] =
+        "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+        "Connection: keep-alive\r\n\r\nretry: 2000\n\n";
+
+    for (uint8_t i = 0; i < SCREEN_STREAM_CLIENTS; i++) {
+        WIFI_ScreenClient_t *client = &screen_clients[i];
+        if (client->pcb != NULL) {
+            continue;
+        }
+
+        struct tcp_pcb *tpcb = http_Detach(conn);
+        client->pcb = tpcb;
+        client->synced = false;
+        client->inflight = sizeof(header) - 1;
+        client->last_ms = 0;
+        tcp_arg(tpcb, client);
+        tcp_recv(tpcb, screen_stream_recv);
+        tcp_sent(tpcb, screen_stream_sent);
+        tcp_err(tpcb, screen_stream_error);
+        tcp_write(tpcb, header, sizeof(header) - 1, 0);
+        tcp_output(tpcb);
+        return;
     }
-     
-    // Envia a resposta HTTP
-    tcp_write(tpcb, http_response, strlen(http_response), TCP_WRITE_FLAG_COPY);
 
-    // Libera o buffer recebido
-    pbuf_free(p);
+    http_Begin(conn, 503, NULL, 0, "Retry-After: 5\r\n");
+}
 
-    return ERR_OK;
+/**
+ * @brief Envia a cada cliente da transmissão o que mudou na tela.
+ *
+ * Chamada do laço principal do Wi-Fi. A tela é lida só quando sai um frame
+ * novo (frame_seq). Um cliente recebe um evento no máximo a cada
+ * SCREEN_STREAM_MIN_MS e só depois do ACK do evento anterior: um navegador
+ * lento perde os frames intermediários (o próximo delta já os inclui) em vez de
+ * acumular eventos no heap do lwIP (MEM_SIZE). Cada evento é
+ * "id: <frame>" + "data: <delta em base64>".
+ */
+static void screen_stream_poll(void)
+{
+    static uint8_t delta[SCREEN_DELTA_MAX];
+    static char event[SCREEN_EVENT_MAX];
+    const uint32_t now = to_ms_since_boot(get_absolute_time());
+    const uint32_t seq = ssd1306_GetFlushStats()->frame_seq;
+
+    cyw43_arch_lwip_begin();
+
+    for (uint8_t i = 0; i < SCREEN_STREAM_CLIENTS; i++) {
+        WIFI_ScreenClient_t *client = &screen_clients[i];
+        if (client->pcb == NULL || client->inflight > 0 || now - client->last_ms < SCREEN_STREAM_MIN_MS) {
+            continue;
+        }
+
+        if (!screen_frame_valid || seq != screen_frame_seq) {
+            for (uint8_t page = 0; page < SCREEN_PAGES; page++) {
+                ssd1306_ReadPage(page, &screen_frame[page * SSD1306_WIDTH]);
+            }
+            screen_frame_seq = seq;
+            screen_frame_valid = true;
+        }
+
+        const uint16_t delta_len = screen_delta(client->shadow, client->synced, delta);
+        uint16_t len;
+        if (delta_len > 0) {
+            len = (uint16_t)snprintf(event, sizeof(event), "id: %lu\ndata: ", (unsigned long)seq);
+            len += screen_base64(delta, delta_len, &event[len]);
+            event[len++] = '\n';
+            event[len++] = '\n';
+        } else if (now - client->last_ms >= SCREEN_STREAM_KEEPALIVE_MS) {
+            len = (uint16_t)snprintf(event, sizeof(event), ":\n\n");
+        } else {
+            continue;
+        }
+
+        if (len > tcp_sndbuf(client->pcb) ||
+            tcp_write(client->pcb, event, len, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+            continue;  // Sem espaço agora: tenta de novo no próximo ciclo
+        }
+        tcp_output(client->pcb);
+
+        if (delta_len > 0) {
+            memcpy(client->shadow, screen_frame, SSD1306_BUFFER_SIZE);
+            client->synced = true;
+        }
+        client->inflight += len;
+        client->last_ms = now;
+    }
+
+    cyw43_arch_lwip_end();
 }
 
 /**
- * @brief Callback de conexão: associa o http_callback à conexão.
- * 
- * Esta função é chamada quando uma nova conexão TCP é estabelecida.
- * Ela associa a função http_callback à conexão para processar as requisições HTTP.
- * 
- * @param arg Argumento genérico (não utilizado).
- * @param newpcb Estrutura que representa a nova conexão TCP.
- * @param err Código de erro (se houver).
- * @return err_t Retorna ERR_OK se a conexão foi configurada com sucesso.
+ * @brief Envia uma página de web/ (inc/webpages.h) direto da flash.
+ *
+ * O cabeçalho vai pelo buffer da conexão; o corpo já está em gzip na flash e
+ * vai por http_WriteRef, aos pedaços que cabem na janela de envio, sem ser
+ * formatado nem montado num buffer da aplicação. Com LWIP_NETIF_TX_SINGLE_PBUF
+ * (lwipopts.h) o tcp_write copia cabeçalho e corpo para pbufs no heap do lwIP
+ * (MEM_SIZE), liberados quando o navegador confirma. Como as páginas cabem em
+ * TCP_SND_BUF, a resposta inteira fica no heap: o tamanho dela mais ~80 bytes
+ * por segmento, com o primeiro reservado com o MSS inteiro. Medido no host
+ * com um modelo do tcp_write: de 1540 bytes (/) a 2596 (/option/display) por
+ * requisição, ou seja, três páginas carregando ao mesmo tempo já ocupam
+ * quase todo o MEM_SIZE de 8 KB; a que não couber recebe ERR_MEM e continua
+ * em http_sent ou http_poll.
  */
-static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err) 
+static void send_page(HTTP_Conn_t *conn, const WEB_Page_t *page)
 {
-    tcp_recv(newpcb, http_callback);  // Associa o callback HTTP
-    return ERR_OK;
+    http_Begin(conn, 200, page->content_type, (int32_t)page->size,
+               "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\nCache-Control: no-cache\r\n");
+    http_WriteRef(conn, page->data, page->size);
 }
 
+// GET /screen/stream: a conexão fica aberta e passa para screen_stream_poll
+static void route_screen_stream(HTTP_Conn_t *conn, const HTTP_Request_t *request, const void *arg)
+{
+    screen_stream_open(conn);
+}
+
+// Páginas de web/: arg é o WEB_Page_t
+static void route_page(HTTP_Conn_t *conn, const HTTP_Request_t *request, const void *arg)
+{
+    send_page(conn, (const WEB_Page_t *)arg);
+}
+
+/* Rotas do servidor: método e caminho exato (sem a query string) */
+static const HTTP_Route_t http_routes[] = {
+    {HTTP_GET, "/",                 route_page,             &web_page_index},
+    {HTTP_GET, "/index.html",       route_page,             &web_page_index},
+    {HTTP_GET, "/option/joystick",  route_page,             &web_page_joystick},
+    {HTTP_GET, "/option/matriz",    route_page,             &web_page_matriz},
+    {HTTP_GET, "/option/buzzer",    route_page,             &web_page_buzzer},
+    {HTTP_GET, "/option/mic",       route_page,             &web_page_microfone},
+    {HTTP_GET, "/option/display",   route_page,             &web_page_display},
+    {HTTP_GET, "/option/wifi",      route_page,             &web_page_wifi},
+    {HTTP_GET, "/screen",           route_screen_bmp,       NULL},
+    {HTTP_GET, "/screen.bmp",       route_screen_bmp,       NULL},
+    {HTTP_GET, "/screen.pbm",       route_screen_pbm,       NULL},
+    {HTTP_GET, "/screen/seq",       route_screen_seq,       NULL},
+    {HTTP_GET, "/screen/stream",    route_screen_stream,    NULL},
+};
+
 /**
  * @brief Inicializa o servidor HTTP na porta 80.
  * 
- * Esta função configura o servidor TCP para escutar na porta 80 e associa
- * a função connection_callback para lidar com novas conexões.
+ * As requisições são lidas e encaminhadas para as rotas de http_routes
+ * pelo servidor de src/http.c.
  */
 static void start_http_server(void) 
 {
-    struct tcp_pcb *pcb = tcp_new();
-    if (!pcb) {
-        printf("Erro ao criar PCB\n");
-        return;
-    }
-
-    // Liga o servidor na porta 80
-    if (tcp_bind(pcb, IP_ADDR_ANY, 80) != ERR_OK) {
+    if (!http_Start(80, http_routes, sizeof(http_routes) / sizeof(http_routes[0]))) {
         printf("Erro ao ligar o servidor na porta 80\n");
         return;
     }
 
-    pcb = tcp_listen(pcb);  // Coloca o PCB em modo de escuta
-    tcp_accept(pcb, connection_callback);  // Associa o callback de conexão
-
     printf("Servidor HTTP rodando na porta 80...\n");
 }
 
@@ -722,6 +509,7 @@ void create_http_request(void) {
     
     float temperature = read_temperature_sensor();
     last_cloud_update = temperature;
+    last_cloud_upload_ms = to_ms_since_boot(get_absolute_time());
 
     snprintf(http_request, sizeof(http_request),
              "GET /update?api_key=WBPKI1T0OOKAI89Q&field1=%.2f HTTP/1.1\r\n"
@@ -846,6 +634,41 @@ bool request_timer_callback(repeating_timer_t *rt) {
     return true; // Mantém o timer ativo
 }
 
+/**
+ * @brief Atualiza os ícones de Wi-Fi e de envio para a nuvem na barra de status.
+ *
+ * A barra fica na sobreposição do display, composta sobre qualquer tela no
+ * flush. Os ícones só são redesenhados quando o estado muda, e a tela ativa não
+ * precisa ser redesenhada para mostrá-los.
+ */
+void wifi_status_bar(void)
+{
+    static int8_t last_link = -1;
+    static int8_t last_cloud = -1;
+
+    const int8_t link = (cyw43_wifi_link_status(&cyw43_state, CYW43_ITF_STA) == CYW43_LINK_JOIN);
+
+    // 0 = nenhum envio ainda, 1 = já enviou, 2 = enviou há pouco
+    int8_t cloud = 0;
+    if (last_cloud_upload_ms) {
+        const uint32_t now = to_ms_since_boot(get_absolute_time());
+        cloud = (now - last_cloud_upload_ms < STATUS_UPLOAD_MS) ? 2 : 1;
+    }
+
+    if (link != last_link) {
+        ssd1306_OverlayBlit(STATUS_WIFI_X, 0, link ? &bitmap_status_wifi_pages : &bitmap_status_wifi_off_pages);
+        last_link = link;
+    }
+    if (cloud != last_cloud) {
+        if (cloud == 0) {
+            ssd1306_OverlayClear(STATUS_CLOUD_X, STATUS_CLOUD_X + 7);
+        } else {
+            ssd1306_OverlayBlit(STATUS_CLOUD_X, 0, (cloud == 2) ? &bitmap_status_upload_pages : &bitmap_status_cloud_pages);
+        }
+        last_cloud = cloud;
+    }
+}
+
 /**
  * @brief Inicializa o Wi-Fi e o servidor HTTP.
  * 
@@ -869,10 +692,15 @@ void WIFI_Init()
     cyw43_arch_enable_sta_mode();
     printf("Conectando ao Wi-Fi...\n");
 
+    // Liga a barra de status (Wi-Fi desconectado até a conexão)
+    wifi_status_bar();
+    ssd1306_OverlayEnable(true);
+
     // Loop para tentar a conexão enquanto ela falhar
     while (cyw43_arch_wifi_connect_timeout_ms(ssid, password, CYW43_AUTH_WPA2_AES_PSK, 10000)) 
     {
         printf("Falha ao conectar ao Wi-Fi. Tente novamente.\n");
+        wifi_status_bar();
 
     }
 
@@ -907,6 +735,9 @@ void WIFI_Init()
             request_pending = false; // Reseta o flag
         }
 
+        wifi_status_bar();
+        screen_stream_poll();
+
         sleep_ms(100);     
     }
 
@@ -924,9 +755,17 @@ void WIFI_Init()
 void WIFI_status(void)
 {
     char status[64];
+    char marquee[64] = "";  // Texto atual do letreiro do SSID
+
+    // 30 fps: o letreiro por software anda 30 pixels por segundo
+    FRAME_Scheduler_t fs;
+    frame_Init(&fs, 30, 0);
 
     while(1)
     {
+        frame_Begin(&fs);
+        idle_poll();
+
         // Limpa o display (fundo branco)
         ssd1306_Fill(White);
 
@@ -952,39 +791,48 @@ void WIFI_status(void)
             snprintf(status, sizeof(status), "Sinal: %d dBm", rssi);
             ssd1306_WriteString(status, Font_7x10, Black);
 
-            // Linha 4: SSID (supondo que a variável global "wifi_ssid" possua o nome da rede)
-            ssd1306_SetCursor(0, 36);
-            snprintf(status, sizeof(status), "SSID: %s", wifi_ssid);
-            ssd1306_WriteString(status, Font_7x10, Black);
-
-            // Linha 5: Endereço MAC
-            ssd1306_SetCursor(0, 48);
+            // Linha 5: Endereço MAC (antes do letreiro, que envia a tela ao começar)
+            ssd1306_SetCursor(0, 56);
             const u8_t *mac = cyw43_state.netif[0].hwaddr;
             snprintf(status, sizeof(status), "MAC: %02X:%02X:%02X:%02X:%02X:%02X",
                      mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
             ssd1306_WriteString(status, Font_6x8, Black);
 
+            // Linha 4: SSID num letreiro (página 5), para nomes que não cabem na tela.
+            // Só é reiniciado quando o texto muda; o scroll por hardware segue sozinho
+            // até o resto da tela mudar (RSSI), e daí o letreiro segue por software.
+            snprintf(status, sizeof(status), "SSID: %s", wifi_ssid);
+            if (strcmp(status, marquee) != 0) {
+                strcpy(marquee, status);
+                ssd1306_Marquee(marquee, &Font_7x10, 5, Black, SSD1306_SCROLL_2_FRAMES);
+            }
+            ssd1306_MarqueeTick();
+
             // Se precisar de mais status (como canal ou modo), pode adicionar outra linha:
             // ssd1306_SetCursor(0, 60);
             // ssd1306_WriteString("Modo: STA", Font_7x10, Black);
         } else {
             // Se não estiver conectado, exibe apenas o status de desconexão
+            ssd1306_MarqueeStop();
+            marquee[0] = '\0';
             ssd1306_SetCursor(0, 0);
             ssd1306_WriteString("WiFi: Desconectado", Font_7x10, Black);
         }
 
         // Atualiza o display para mostrar as mudanças
-        ssd1306_UpdateScreen();
+        ssd1306_UpdateScreenAsync();
 
         // Se o botão no pino 22 for pressionado, retorna ao menu principal
-        if (gpio_get(22) == 0)
+        if (idle_button())
         {
             DEBOUNCE;
+            ssd1306_MarqueeStop();
+            frame_PrintStats(&fs, "wifi");
             wifi_home();
             break;
         }
 
-        POLLING_TIME;  // Delay para evitar sobrecarga (defina este macro conforme sua necessidade)
+        frame_End(&fs);
     }
 }
 
@@ -997,8 +845,15 @@ void webserver_status(void)
 {
     char status[64];
 
+    // O status muda devagar: 10 fps bastam
+    FRAME_Scheduler_t fs;
+    frame_Init(&fs, 10, 0);
+
     while(1)
     {
+        frame_Begin(&fs);
+        idle_poll();
+
         // Limpa o display (fundo branco)
         ssd1306_Fill(White);
 
@@ -1023,16 +878,17 @@ void webserver_status(void)
         }
 
         // Atualiza o display para mostrar as mudanças
-        ssd1306_UpdateScreen();
+        ssd1306_UpdateScreenAsync();
 
         // Se o botão no pino 22 for pressionado, retorna ao menu principal
-        if (gpio_get(22) == 0)
+        if (idle_button())
         {
             DEBOUNCE;
+            frame_PrintStats(&fs, "cloud");
             wifi_home();
             break;
         }
 
-        POLLING_TIME;  // Delay para evitar sobrecarga (defina este macro conforme sua necessidade)
+        frame_End(&fs);
     }
 }
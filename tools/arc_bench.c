@@ -0,0 +1,241 @@
+/**
+ * @file arc_bench.c
+ * @brief Arcos com a tabela de senos contra ponto flutuante: tempo por arco e pixels.
+ *
+ * Tempo: o ssd1306_DrawArc original (sinf/cosf, pi = 3.14, truncamento) contra
+ * o atual (seno Q14 por tabela), nos mesmos arcos pseudoaleatórios; sai em
+ * nanossegundos e em ciclos do contador de tempo do processador (TSC, só em
+ * x86). Na placa, a linha DrawArc do display_bench dá os ciclos do M0+.
+ *
+ * Pixels: cada arco (com e sem as linhas de raio) é comparado com um modelo
+ * em double da mesma geometria (mesmos ângulos, sin/cos exatos da libm,
+ * arredondamento para o mais próximo).
+ * Os pontos da tabela ficam a menos de ARC_TIE_EPS pixel do valor exato, então
+ * só um ponto a menos disso de um empate (.5) pode arredondar para o outro
+ * lado. A tolerância é explícita: arcos sem ponto nessa faixa têm que sair
+ * idênticos ao modelo; os demais podem diferir, mas cada pixel aceso de um tem
+ * que estar a no máximo ARC_TOLERANCE_PX do outro. Retorna 1 se algum arco
+ * passar da tolerância.
+ *
+ * Uso: arc_bench
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "inc/display.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define arc_cycles() __rdtsc()
+#else
+#define arc_cycles() 0ull
+#endif
+
+#define ARCS                2000
+#define ARC_TIE_EPS         0.01    // Erro máximo (px) do seno da tabela com raio 63
+#define ARC_TOLERANCE_PX    1       // Distância máxima (Chebyshev) entre pixels dos dois desenhos
+#define BENCH_MIN_US        200000
+
+#define ARC_SEGMENTS        36      // CIRCLE_APPROXIMATION_SEGMENTS de display.c
+
+typedef struct {
+    uint8_t x, y, radius;
+    uint16_t start, sweep;
+} Arc_t;
+
+static SSD1306_t panel;
+static Arc_t Arcs[ARCS];
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static uint16_t normalize_0_360(uint16_t deg) {
+    if (deg <= 360) {
+        return deg;
+    }
+    deg %= 360;
+    return deg ? deg : 360;
+}
+
+/* ssd1306_DrawArc de antes: sinf/cosf por ponto, pi = 3.14 e truncamento */
+static void float_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
+    uint32_t loc_sweep = normalize_0_360(sweep);
+    uint32_t count = (normalize_0_360(start_angle) * ARC_SEGMENTS) / 360;
+    uint32_t approx_segments = (loc_sweep * ARC_SEGMENTS) / 360;
+    float approx_degree = loc_sweep / (float)approx_segments;
+    float rad;
+
+    while (count < approx_segments) {
+        rad = count * approx_degree * (3.14f / 180.0f);
+        uint8_t xp1 = x + (int8_t)(sinf(rad) * radius);
+        uint8_t yp1 = y + (int8_t)(cosf(rad) * radius);
+        count++;
+        rad = ((count != approx_segments) ? count * approx_degree : loc_sweep) * (3.14f / 180.0f);
+        uint8_t xp2 = x + (int8_t)(sinf(rad) * radius);
+        uint8_t yp2 = y + (int8_t)(cosf(rad) * radius);
+        ssd1306_Line(xp1, yp1, xp2, yp2, color);
+    }
+}
+
+/* Coordenada exata arredondada para o mais próximo; marca se estava perto de um empate */
+static int8_t model_round(double v, int* near_tie) {
+    double frac = fabs(v) - floor(fabs(v));
+    if (fabs(frac - 0.5) < ARC_TIE_EPS) {
+        *near_tie = 1;
+    }
+    return (int8_t)((v >= 0) ? floor(v + 0.5) : -floor(-v + 0.5));
+}
+
+/* Modelo em double de ssd1306_ArcSegments; retorna se algum ponto ficou perto de um empate */
+static int model_Arc(const Arc_t* a, int radius_lines, SSD1306_COLOR color) {
+    const uint32_t loc_sweep = normalize_0_360(a->sweep);
+    const uint32_t segments = (loc_sweep * ARC_SEGMENTS) / 360;
+    uint32_t count = (normalize_0_360(a->start) * ARC_SEGMENTS) / 360;
+    int near_tie = 0;
+    uint8_t px[ARC_SEGMENTS + 2], py[ARC_SEGMENTS + 2];
+    uint32_t n = 0;
+
+    for (uint32_t k = count; n == 0 || k <= segments; k++) {
+        // Mesmos ângulos da implementação (1/16 de grau); só o seno é exato
+        double deg = segments ? (double)((k * loc_sweep * 16) / segments) / 16.0 : 0;
+        double rad = deg * M_PI / 180.0;
+        px[n] = a->x + model_round(sin(rad) * a->radius, &near_tie);
+        py[n] = a->y + model_round(cos(rad) * a->radius, &near_tie);
+        n++;
+        if (k >= segments) {
+            break;
+        }
+    }
+    for (uint32_t i = 1; i < n; i++) {
+        ssd1306_Line(px[i - 1], py[i - 1], px[i], py[i], color);
+    }
+    if (radius_lines) {
+        ssd1306_Line(a->x, a->y, px[0], py[0], color);
+        ssd1306_Line(a->x, a->y, px[n - 1], py[n - 1], color);
+    }
+    return near_tie;
+}
+
+static bool lit(const uint8_t* buf, int x, int y) {
+    return (buf[(y / 8) * panel.Width + x] >> (y % 8)) & 1;
+}
+
+/* Todo pixel aceso de a tem um aceso em b a até ARC_TOLERANCE_PX */
+static bool within_tolerance(const uint8_t* a, const uint8_t* b) {
+    for (int y = 0; y < panel.Height; y++) {
+        for (int x = 0; x < panel.Width; x++) {
+            if (!lit(a, x, y)) {
+                continue;
+            }
+            bool found = false;
+            for (int dy = -ARC_TOLERANCE_PX; dy <= ARC_TOLERANCE_PX && !found; dy++) {
+                for (int dx = -ARC_TOLERANCE_PX; dx <= ARC_TOLERANCE_PX && !found; dx++) {
+                    int nx = x + dx, ny = y + dy;
+                    found = nx >= 0 && ny >= 0 && nx < panel.Width && ny < panel.Height && lit(b, nx, ny);
+                }
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Tempo médio por arco (ns e ciclos) desenhando a lista inteira várias vezes.
+ * Com points_only os arcos têm raio 0: as retas viram um pixel e sobra o custo
+ * de calcular os pontos, que é o que mudou. */
+static void time_arcs(int reference, int points_only, double* ns, double* cycles) {
+    uint64_t start = now_us(), c0 = arc_cycles(), elapsed;
+    uint32_t runs = 0;
+
+    do {
+        for (uint32_t i = 0; i < ARCS; i++) {
+            const Arc_t *a = &Arcs[i];
+            const uint8_t radius = points_only ? 0 : a->radius;
+            if (reference) {
+                float_DrawArc(a->x, a->y, radius, a->start, a->sweep, (i & 1) ? White : Black);
+            } else {
+                ssd1306_DrawArc(a->x, a->y, radius, a->start, a->sweep, (i & 1) ? White : Black);
+            }
+        }
+        runs += ARCS;
+        elapsed = now_us() - start;
+    } while (elapsed < BENCH_MIN_US);
+    *ns = elapsed * 1000.0 / runs;
+    *cycles = (double)(arc_cycles() - c0) / runs;
+}
+
+int main(void) {
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .rotation = SSD1306_ROTATE_0,
+    };
+    static uint8_t expected[SSD1306_MAX_BUFFER_SIZE];
+    uint32_t identical = 0, ties = 0, failures = 0;
+    uint32_t seed = 2024;
+
+    ssd1306_InitDisplay(&panel, &config);
+    ssd1306_Select(&panel);
+    const size_t size = panel.Width * panel.Pages;
+
+    for (uint32_t i = 0; i < ARCS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        Arcs[i].x = (seed >> 8) % panel.Width;
+        Arcs[i].y = (seed >> 16) % panel.Height;
+        seed = seed * 1103515245u + 12345u;
+        Arcs[i].radius = 1 + (seed >> 8) % 63;
+        Arcs[i].start = (seed >> 16) % 360;
+        seed = seed * 1103515245u + 12345u;
+        Arcs[i].sweep = 1 + (seed >> 8) % 360;
+    }
+
+    for (uint32_t i = 0; i < ARCS; i++) {
+        const Arc_t *a = &Arcs[i];
+        const int radius_lines = i & 1;
+
+        ssd1306_Fill(Black);
+        int near_tie = model_Arc(a, radius_lines, White);
+        memcpy(expected, panel.Buffer, size);
+
+        ssd1306_Fill(Black);
+        if (radius_lines) {
+            ssd1306_DrawArcWithRadiusLine(a->x, a->y, a->radius, a->start, a->sweep, White);
+        } else {
+            ssd1306_DrawArc(a->x, a->y, a->radius, a->start, a->sweep, White);
+        }
+
+        ties += near_tie;
+        if (memcmp(expected, panel.Buffer, size) == 0) {
+            identical++;
+        } else if (!near_tie || !within_tolerance(expected, panel.Buffer) ||
+                   !within_tolerance(panel.Buffer, expected)) {
+            printf("arco %u: (%u,%u) r=%u %u+%u graus fora da tolerancia\n",
+                   i, a->x, a->y, a->radius, a->start, a->sweep);
+            failures++;
+        }
+    }
+
+    printf("arcos: %u, identicos ao modelo: %u, com ponto a menos de %.2f px de um empate: %u, "
+           "fora da tolerancia (%d px): %u\n",
+           ARCS, identical, ARC_TIE_EPS, ties, ARC_TOLERANCE_PX, failures);
+    printf("versao      desenho  ns/arco  ciclos/arco\n");
+    for (int points_only = 0; points_only < 2; points_only++) {
+        for (int reference = 1; reference >= 0; reference--) {
+            double ns, cycles;
+            time_arcs(reference, points_only, &ns, &cycles);
+            printf("%-11s %-7s %8.0f  %11.0f\n", reference ? "sinf/cosf" : "tabela Q14",
+                   points_only ? "r=0" : "arco", ns, cycles);
+        }
+    }
+    return failures ? 1 : 0;
+}
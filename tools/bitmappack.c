@@ -0,0 +1,138 @@
+/**
+ * @file bitmappack.c
+ * @brief Converte bitmaps de src/icons.c para o formato página a página do SSD1306.
+ *
+ * Os bitmaps de src/icons.c estão linha a linha (1 bit por pixel, bit 7 à
+ * esquerda, cada linha começando num byte novo). A saída é um .c com cada
+ * bitmap como SSD1306_Bitmap_t: colunas verticais de 8 pixels, página a
+ * página, no formato da GDDRAM, prontas para ssd1306_BlitBitmap.
+ *
+ * Uso: bitmappack <icons.c> <saida.c> <nome>:<L>x<A>[:<máscara>] ...
+ *
+ * Cada bitmap gera "const SSD1306_Bitmap_t <nome>_pages". A máscara opcional
+ * é outro bitmap do mesmo tamanho (bits 1 = pixels desenhados).
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srcparse.h"
+
+#define MAX_ARRAYS 32
+
+/* Vetor "const unsigned char nome[] = {...};" encontrado no arquivo */
+typedef struct {
+    char name[SRCPARSE_NAME_LEN];
+    uint32_t *values;
+    size_t count;
+} Array_t;
+
+static Array_t arrays[MAX_ARRAYS];
+static size_t array_count = 0;
+
+static void parse(const char *src) {
+    static const char prefix[] = "const unsigned char";
+    const char *p = src;
+
+    while (*p) {
+        const char *line = srcparse_skip_space(p);
+
+        p = line;
+        if (strncmp(line, prefix, sizeof(prefix) - 1) == 0) {
+            Array_t *a;
+            if (array_count >= MAX_ARRAYS) {
+                srcparse_die("bitmaps demais", NULL);
+            }
+            a = &arrays[array_count++];
+            p = srcparse_ident(line + sizeof(prefix) - 1, a->name);
+            p = srcparse_values(p, &a->values, &a->count, a->name);
+        }
+        p = srcparse_next_line(p);
+    }
+}
+
+static const Array_t* find_array(const char *name) {
+    for (size_t i = 0; i < array_count; i++) {
+        if (strcmp(arrays[i].name, name) == 0) {
+            return &arrays[i];
+        }
+    }
+    srcparse_die("bitmap não encontrado", name);
+    return NULL;
+}
+
+/**
+ * @brief Escreve o bitmap convertido para páginas como um vetor uint8_t.
+ *
+ */
+static void emit_pages(FILE *out, const char *name, const Array_t *a, unsigned w, unsigned h) {
+    const unsigned row_bytes = (w + 7) / 8;
+    const unsigned pages = (h + 7) / 8;
+
+    if (a->count < (size_t)row_bytes * h) {
+        srcparse_die("bitmap menor que as dimensões pedidas", a->name);
+    }
+
+    fprintf(out, "static const uint8_t %s[] = {", name);
+    for (unsigned p = 0; p < pages; p++) {
+        for (unsigned x = 0; x < w; x++) {
+            uint8_t b = 0;
+            for (unsigned r = 0; r < 8 && p * 8 + r < h; r++) {
+                if (a->values[(p * 8 + r) * row_bytes + x / 8] & (0x80 >> (x % 8))) {
+                    b |= 1 << r;
+                }
+            }
+            fputs((x % 16) ? " " : "\n    ", out);
+            fprintf(out, "0x%02X,", b);
+        }
+    }
+    fprintf(out, "\n};\n");
+}
+
+int main(int argc, char **argv) {
+    srcparse_set_tool("bitmappack");
+    if (argc < 4) {
+        fprintf(stderr, "uso: %s <icons.c> <saida.c> <nome>:<L>x<A>[:<máscara>] ...\n", argv[0]);
+        return 1;
+    }
+
+    char *src = srcparse_load(argv[1]);
+    parse(src);
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out) {
+        srcparse_die("não foi possível criar", argv[2]);
+    }
+    fprintf(out, "/* Gerado por tools/bitmappack a partir de %s. Não edite. */\n\n", argv[1]);
+    fprintf(out, "#include \"inc/icons.h\"\n\n");
+
+    for (int i = 3; i < argc; i++) {
+        char name[SRCPARSE_NAME_LEN], mask[SRCPARSE_NAME_LEN] = "";
+        char data_name[2 * SRCPARSE_NAME_LEN], mask_name[2 * SRCPARSE_NAME_LEN];
+        unsigned w, h;
+
+        if (sscanf(argv[i], "%63[A-Za-z0-9_]:%ux%u:%63[A-Za-z0-9_]", name, &w, &h, mask) < 3 ||
+            w == 0 || w > 255 || h == 0 || h > 255) {
+            srcparse_die("especificação inválida (nome:LxA[:máscara])", argv[i]);
+        }
+
+        snprintf(data_name, sizeof(data_name), "%s_pages_data", name);
+        emit_pages(out, data_name, find_array(name), w, h);
+        if (mask[0]) {
+            snprintf(mask_name, sizeof(mask_name), "%s_pages_mask", name);
+            emit_pages(out, mask_name, find_array(mask), w, h);
+        }
+        fprintf(out, "const SSD1306_Bitmap_t %s_pages = {%u, %u, %s, %s};\n\n",
+                name, w, h, data_name, mask[0] ? mask_name : "NULL");
+
+        printf("bitmappack: %s %ux%u -> %u bytes\n", name, w, h, w * ((h + 7) / 8) * (mask[0] ? 2 : 1));
+    }
+
+    if (fclose(out) != 0) {
+        srcparse_die("falha ao gravar", argv[2]);
+    }
+    free(src);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file cmd_transactions.c
+ * @brief Confere no I2C emulado quantas transações cada sequência de comandos usa.
+ *
+ * Os comandos vão em sequências (0x00 + vários comandos numa transação): a
+ * inicialização inteira numa, SetContrast e SetDisplayOn numa cada, e cada
+ * janela do flush em duas (preâmbulo 0x21/0x22 e, com RESTART, os dados).
+ * Cada START ou RESTART conta como uma transação no painel emulado. Para
+ * comparação, imprime quantas seriam com um ssd1306_WriteCommand por byte de
+ * comando. Retorna 1 se alguma contagem não for a esperada.
+ *
+ * Uso: cmd_transactions
+ */
+
+#include <stdio.h>
+
+#include "inc/display.h"
+
+static SSD1306_t panel;
+static int failures = 0;
+
+/* Transações recebidas pelo painel emulado desde o power-on */
+static uint32_t panel_transactions(void) {
+    ssd1306_HostSelect(panel.I2c, panel.Address);
+    return ssd1306_HostState()->transactions;
+}
+
+static void expect(const char* what, uint32_t got, uint32_t expected, uint32_t per_command) {
+    printf("%-28s %6u %6u\n", what, per_command, got);
+    if (got != expected) {
+        printf("  esperadas %u transações\n", expected);
+        failures++;
+    }
+}
+
+int main(void) {
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .rotation = SSD1306_ROTATE_0,
+    };
+
+    printf("sequencia                    antes  agora\n");
+
+    // Inicialização + primeiro frame (tela inteira numa janela)
+    ssd1306_InitDisplay(&panel, &config);
+    ssd1306_Select(&panel);
+    ssd1306_HostSelect(panel.I2c, panel.Address);
+    const SSD1306_HostState_t *s = ssd1306_HostState();
+    uint32_t init_commands = s->bytes - panel.Stats.last_sent - 1;
+    expect("init + primeiro frame", s->transactions, 3, init_commands + panel.Pages * 4);
+    if (!s->display_on || s->multiplex != SSD1306_HEIGHT - 1 || s->contrast != 0xFF ||
+        !s->segment_remap || !s->com_reverse) {
+        printf("  registradores do painel diferentes dos da inicialização\n");
+        failures++;
+    }
+
+    uint32_t before = panel_transactions();
+    ssd1306_SetContrast(0x40);
+    expect("SetContrast", panel_transactions() - before, 1, 2);
+
+    before = panel_transactions();
+    ssd1306_SetDisplayOn(0);
+    ssd1306_SetDisplayOn(1);
+    expect("SetDisplayOn (x2)", panel_transactions() - before, 2, 2);
+
+    // Um retângulo: uma janela; dois afastados: duas janelas
+    before = panel_transactions();
+    ssd1306_FillRectangle(4, 4, 20, 12, White);
+    ssd1306_UpdateScreen();
+    expect("flush, 1 janela (2 paginas)", panel_transactions() - before, 2, 2 * 4);
+
+    before = panel_transactions();
+    ssd1306_FillRectangle(0, 0, 10, 5, Black);
+    ssd1306_FillRectangle(100, 50, 120, 60, White);
+    ssd1306_UpdateScreen();
+    expect("flush, 2 janelas", panel_transactions() - before, 4, 3 * 4);
+    if (panel.Stats.last_transactions != 4) {
+        printf("  ssd1306_GetFlushStats conta %u transações\n", panel.Stats.last_transactions);
+        failures++;
+    }
+
+    before = panel_transactions();
+    ssd1306_FillRectangle(0, 0, 10, 5, White);
+    ssd1306_FillRectangle(100, 50, 120, 60, Black);
+    ssd1306_UpdateScreenAsync();
+    ssd1306_WaitFlush();
+    expect("flush assincrono, 2 janelas", panel_transactions() - before, 4, 3 * 4);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file flush_report.c
+ * @brief Bytes por frame no I2C emulado para telas redesenhadas por inteiro.
+ *
+ * Repete o laço de joystick_pos (ssd1306_Fill + cabeçalho + retângulos + dois
+ * valores, a cada frame) e o de mic_test (só a área do estado) sobre o display
+ * do host e mostra, por cenário, os bytes por frame que chegaram ao painel
+ * emulado, contra os que o mesmo desenho custava antes da comparação com o
+ * último envio (um segundo painel, sem a cópia). Também confere, a cada
+ * frame, que o painel emulado mostra exatamente o buffer e que o número de
+ * sequência (frame_seq) avança exatamente nos frames em que a imagem muda.
+ * Retorna 1 se a imagem divergir, se um frame idêntico
+ * ao anterior mandar algum byte ou se frame_seq não acompanhar a imagem.
+ *
+ * Uso: flush_report
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "inc/display.h"
+#include "inc/fonts.h"
+
+#define REPORT_FRAMES   60
+
+// Dois painéis recebem o mesmo desenho: o de referência esquece a cópia do
+// último envio antes de cada flush e manda tudo o que foi marcado, como antes
+static SSD1306_t panel;
+static SSD1306_t reference;
+
+/* Leituras do joystick: paradas nos primeiros frames, depois variando */
+static void joystick_sample(uint32_t frame, uint16_t* x, uint16_t* y) {
+    if (frame < REPORT_FRAMES / 3) {
+        *x = 2048;
+        *y = 2050;
+        return;
+    }
+    *x = 2048 + (uint16_t)((frame * 37) % 400);
+    *y = 1900 + (uint16_t)((frame * 53) % 300);
+}
+
+/* Um frame de joystick_pos (src/joystick.c) */
+static void draw_joystick(uint32_t frame) {
+    uint16_t vrx_value, vry_value;
+    char buffer[32];
+
+    joystick_sample(frame, &vrx_value, &vry_value);
+    ssd1306_Fill(White);
+    ssd1306_SetCursor(25, 2);
+    ssd1306_WriteString("JOYSTICK POS", Font_7x10, Black);
+    ssd1306_DrawRectangle(10, 16, 60, 46, Black);
+    ssd1306_DrawRectangle(68, 16, 118, 46, Black);
+
+    sprintf(buffer, "X: %u", vrx_value);
+    ssd1306_SetCursor(10 + (50 - strlen(buffer) * Font_7x10.width) / 2 + 1, 16 + (30 - Font_7x10.height) / 2);
+    ssd1306_WriteString(buffer, Font_7x10, Black);
+    sprintf(buffer, "Y: %u", vry_value);
+    ssd1306_SetCursor(68 + (50 - strlen(buffer) * Font_7x10.width) / 2 + 1, 16 + (30 - Font_7x10.height) / 2);
+    ssd1306_WriteString(buffer, Font_7x10, Black);
+}
+
+/* Um frame de mic_test (src/microfone.c): o estado troca a cada 10 frames */
+static void draw_mic(uint32_t frame) {
+    char micState[20];
+
+    if (frame == 0) {
+        ssd1306_Fill(White);
+        ssd1306_SetCursor(32, 2);
+        ssd1306_WriteString("Teste Mic", Font_7x10, Black);
+    }
+    snprintf(micState, sizeof(micState), "%-15s", ((frame / 10) % 2) ? "microfone on" : "microfone off");
+    ssd1306_FillRectangle(11, 21, 116, 48, White);
+    ssd1306_SetCursor(15, 30);
+    ssd1306_WriteString(micState, Font_7x10, Black);
+}
+
+/* O painel emulado mostra o buffer inteiro */
+static int panel_matches(void) {
+    uint8_t row[SSD1306_MAX_WIDTH / 8];
+
+    for (uint8_t y = 0; y < panel.Height; y++) {
+        ssd1306_ReadRow(y, row);
+        for (uint8_t x = 0; x < panel.Width; x++) {
+            bool on = (row[x / 8] >> (7 - x % 8)) & 1;
+            if (on != ssd1306_HostPixel(x, y)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* Desenha o frame num painel e retorna os bytes que chegaram a ele */
+static uint32_t flush(SSD1306_t* dev, void (*draw)(uint32_t frame), uint32_t frame) {
+    ssd1306_Select(dev);
+    draw(frame);
+    if (dev == &reference) {
+        dev->ShownValid = 0;
+    }
+    ssd1306_UpdateScreen();
+    return dev->Stats.last_sent;
+}
+
+/* Roda um cenário e imprime as médias por frame; retorna o número de falhas */
+static int report(const char* name, void (*draw)(uint32_t frame)) {
+    static uint8_t previous[SSD1306_MAX_BUFFER_SIZE];
+    const size_t size = panel.Width * panel.Pages;
+    uint32_t full_total = 0, sent_total = 0, idle_frames = 0;
+    int failures = 0;
+
+    memcpy(previous, panel.Buffer, size);
+    for (uint32_t frame = 0; frame < REPORT_FRAMES; frame++) {
+        full_total += flush(&reference, draw, frame);
+
+        uint32_t seq = panel.Stats.frame_seq;
+        uint32_t sent = flush(&panel, draw, frame);
+        const bool changed = memcmp(previous, panel.Buffer, size) != 0;
+        memcpy(previous, panel.Buffer, size);
+        if (panel.Stats.frame_seq - seq != (changed ? 1u : 0u)) {
+            printf("%s: frame %u: frame_seq avancou %u com a imagem %s\n", name, frame,
+                   panel.Stats.frame_seq - seq, changed ? "mudada" : "igual");
+            failures++;
+        }
+        ssd1306_HostSelect(panel.I2c, panel.Address);
+        if (ssd1306_HostState()->bytes != panel.BusBytes) {
+            printf("%s: frame %u: contagem do driver difere do barramento\n", name, frame);
+            failures++;
+        }
+        sent_total += sent;
+        idle_frames += (sent == 0);
+
+        if (!panel_matches()) {
+            printf("%s: frame %u: painel diferente do buffer\n", name, frame);
+            failures++;
+        }
+
+        // O mesmo frame de novo não pode mandar nada
+        seq = panel.Stats.frame_seq;
+        if (flush(&panel, draw, frame) != 0 || panel.Stats.frame_seq != seq) {
+            printf("%s: frame %u repetido enviou %u bytes\n", name, frame, panel.Stats.last_sent);
+            failures++;
+        }
+    }
+
+    printf("%-10s %8u %8u %8u %8u\n", name,
+           full_total / REPORT_FRAMES, sent_total / REPORT_FRAMES,
+           (full_total - sent_total) / REPORT_FRAMES, idle_frames);
+    return failures;
+}
+
+int main(void) {
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .rotation = SSD1306_ROTATE_0,
+    };
+    int failures = 0;
+
+    ssd1306_InitDisplay(&panel, &config);
+    config.address = SSD1306_I2C_ADDR + 1;
+    ssd1306_InitDisplay(&reference, &config);
+
+    printf("cenario    antes/fr  agora/fr  econ/fr  frames sem envio (de %u)\n", REPORT_FRAMES);
+    failures += report("joystick", draw_joystick);
+    failures += report("mic", draw_mic);
+    return failures ? 1 : 0;
+}
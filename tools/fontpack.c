@@ -0,0 +1,271 @@
+/**
+ * @file fontpack.c
+ * @brief Compilador de fontes executado no host durante a compilação.
+ *
+ * Lê as tabelas de src/fonts.c (uma linha de 16 bits por linha do glifo, bit 15
+ * na coluna da esquerda) e gera um .c com as mesmas fontes já no formato da
+ * GDDRAM do SSD1306: colunas verticais de 8 pixels, página a página. Quando
+ * compensa, as colunas vazias nas bordas de cada glifo são descartadas e cada
+ * glifo ganha sua própria largura (SSD1306_PackedFont_t.offsets/first_col).
+ *
+ * Uso: fontpack <fonts.c> <saida.c>
+ *
+ * A economia de flash de cada fonte é impressa na saída padrão, que aparece
+ * no log da compilação.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srcparse.h"
+
+#define GLYPHS      (126 - 32 + 1)
+#define MAX_TABLES  16
+#define MAX_FONTS   16
+#define NAME_LEN    SRCPARSE_NAME_LEN
+
+/* Tabela "static const <tipo> nome[] = {...};" encontrada no arquivo */
+typedef struct {
+    char name[NAME_LEN];
+    char guard[NAME_LEN];   // Macro do #ifdef que envolve a tabela ("" se nenhum)
+    int is_u8;              // 1 para uint8_t (larguras), 0 para uint16_t (glifos)
+    uint32_t *values;
+    size_t count;
+} Table_t;
+
+/* Fonte "const SSD1306_Font_t nome = {w, h, tabela, larguras};" */
+typedef struct {
+    char name[NAME_LEN];
+    char guard[NAME_LEN];
+    unsigned width, height;
+    const Table_t *data;
+    const Table_t *char_width;
+} Font_t;
+
+static Table_t tables[MAX_TABLES];
+static size_t table_count = 0;
+static Font_t fonts[MAX_FONTS];
+static size_t font_count = 0;
+
+static const Table_t* find_table(const char *name) {
+    for (size_t i = 0; i < table_count; i++) {
+        if (strcmp(tables[i].name, name) == 0) {
+            return &tables[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Percorre o fonte linha a linha, guardando tabelas e definições de fontes.
+ *
+ */
+static void parse(const char *src) {
+    char guard[NAME_LEN] = "";
+    const char *p = src;
+
+    while (*p) {
+        const char *line = srcparse_skip_space(p);
+
+        if (strncmp(line, "#ifdef", 6) == 0) {
+            p = srcparse_ident(line + 6, guard);
+        } else if (strncmp(line, "#endif", 6) == 0) {
+            guard[0] = '\0';
+            p = line + 6;
+        } else if (strncmp(line, "static const uint16_t", 21) == 0 ||
+                   strncmp(line, "static const uint8_t", 20) == 0) {
+            Table_t *t;
+            if (table_count >= MAX_TABLES) {
+                srcparse_die("tabelas demais", NULL);
+            }
+            t = &tables[table_count++];
+            t->is_u8 = (strncmp(line, "static const uint8_t", 20) == 0);
+            p = srcparse_ident(line + (t->is_u8 ? 20 : 21), t->name);
+            strcpy(t->guard, guard);
+
+            p = srcparse_values(p, &t->values, &t->count, t->name);
+        } else if (strncmp(line, "const SSD1306_Font_t", 20) == 0) {
+            Font_t *f;
+            char data[NAME_LEN], widths[NAME_LEN];
+            if (font_count >= MAX_FONTS) {
+                srcparse_die("fontes demais", NULL);
+            }
+            f = &fonts[font_count++];
+            p = srcparse_ident(line + 20, f->name);
+            strcpy(f->guard, guard);
+
+            p = strchr(p, '{');
+            if (!p || sscanf(p + 1, " %u , %u , %63[A-Za-z0-9_] , %63[A-Za-z0-9_]",
+                             &f->width, &f->height, data, widths) != 4) {
+                srcparse_die("definição de fonte inválida", f->name);
+            }
+            f->data = find_table(data);
+            if (!f->data || f->data->is_u8) {
+                srcparse_die("tabela de glifos não encontrada", data);
+            }
+            f->char_width = strcmp(widths, "NULL") ? find_table(widths) : NULL;
+            if (strcmp(widths, "NULL") && !f->char_width) {
+                srcparse_die("tabela de larguras não encontrada", widths);
+            }
+            if (f->width == 0 || f->width > 16 || f->height == 0 ||
+                f->data->count < (size_t)GLYPHS * f->height) {
+                srcparse_die("dimensões incompatíveis com a tabela", f->name);
+            }
+        } else {
+            p = line;
+        }
+
+        p = srcparse_next_line(p);
+    }
+}
+
+/* Coluna c (0 = esquerda) da página pg do glifo g, no formato da GDDRAM */
+static uint8_t glyph_column(const Font_t *f, unsigned g, unsigned pg, unsigned c) {
+    uint8_t b = 0;
+    for (unsigned r = 0; r < 8 && pg * 8 + r < f->height; r++) {
+        uint32_t row = f->data->values[g * f->height + pg * 8 + r];
+        if ((row << c) & 0x8000) {
+            b |= 1 << r;
+        }
+    }
+    return b;
+}
+
+static void emit_bytes(FILE *out, const char *type, const char *name, const uint32_t *v, size_t n,
+                       int hex) {
+    fprintf(out, "static const %s %s[] = {", type, name);
+    for (size_t i = 0; i < n; i++) {
+        fputs((i % 16) ? " " : "\n    ", out);
+        fprintf(out, hex ? "0x%02X," : "%u,", (unsigned)v[i]);
+    }
+    fprintf(out, "\n};\n");
+}
+
+/**
+ * @brief Gera a versão compactada de uma fonte e retorna o tamanho em bytes.
+ *
+ */
+static size_t emit_font(FILE *out, const Font_t *f) {
+    const unsigned pages = (f->height + 7) / 8;
+    uint32_t *fixed = malloc(sizeof(uint32_t) * GLYPHS * f->width * pages);
+    uint32_t *trimmed = malloc(sizeof(uint32_t) * GLYPHS * f->width * pages);
+    uint32_t offsets[GLYPHS + 1], first_col[GLYPHS];
+    size_t fixed_len = 0, trimmed_len = 0;
+
+    for (unsigned g = 0; g < GLYPHS; g++) {
+        unsigned first = f->width, last = 0;
+
+        for (unsigned pg = 0; pg < pages; pg++) {
+            for (unsigned c = 0; c < f->width; c++) {
+                uint8_t b = glyph_column(f, g, pg, c);
+                fixed[fixed_len++] = b;
+                if (b) {
+                    first = (c < first) ? c : first;
+                    last = (c > last) ? c : last;
+                }
+            }
+        }
+
+        // Glifos vazios (espaço) não guardam nenhuma coluna
+        offsets[g] = (uint32_t)trimmed_len;
+        first_col[g] = (first <= last) ? first : 0;
+        if (first <= last) {
+            for (unsigned pg = 0; pg < pages; pg++) {
+                for (unsigned c = first; c <= last; c++) {
+                    trimmed[trimmed_len++] = glyph_column(f, g, pg, c);
+                }
+            }
+        }
+    }
+    offsets[GLYPHS] = (uint32_t)trimmed_len;
+
+    // Larguras por glifo só compensam se o corte economizar mais que as tabelas extras.
+    // A fonte sai sempre em colunas, mesmo quando fica maior que a original
+    // (fontes altas, com a última página quase vazia, como a 16x26): em linhas
+    // cada glifo seria desenhado pixel a pixel, umas 15 vezes mais devagar.
+    const size_t index_size = sizeof(uint16_t) * (GLYPHS + 1) + GLYPHS;
+    const size_t trimmed_size = (trimmed_len <= UINT16_MAX) ? trimmed_len + index_size : SIZE_MAX;
+    char name[2 * NAME_LEN];
+    size_t size;
+
+    if (f->guard[0]) {
+        fprintf(out, "#ifdef %s\n", f->guard);
+    }
+
+    snprintf(name, sizeof(name), "%s_columns", f->name);
+    if (trimmed_size < fixed_len) {
+        emit_bytes(out, "uint8_t", name, trimmed, trimmed_len, 1);
+        snprintf(name, sizeof(name), "%s_offsets", f->name);
+        emit_bytes(out, "uint16_t", name, offsets, GLYPHS + 1, 0);
+        snprintf(name, sizeof(name), "%s_first_col", f->name);
+        emit_bytes(out, "uint8_t", name, first_col, GLYPHS, 0);
+        fprintf(out, "static const SSD1306_PackedFont_t %s_packed = {%s_columns, %s_offsets, %s_first_col};\n",
+                f->name, f->name, f->name, f->name);
+        size = trimmed_size;
+    } else {
+        emit_bytes(out, "uint8_t", name, fixed, fixed_len, 1);
+        fprintf(out, "static const SSD1306_PackedFont_t %s_packed = {%s_columns, NULL, NULL};\n",
+                f->name, f->name);
+        size = fixed_len;
+    }
+
+    snprintf(name, sizeof(name), "%s_char_width", f->name);
+    if (f->char_width) {
+        emit_bytes(out, "uint8_t", name, f->char_width->values, f->char_width->count, 0);
+        size += f->char_width->count;
+    }
+    fprintf(out, "const SSD1306_Font_t %s = {%u, %u, NULL, %s, &%s_packed};\n",
+            f->name, f->width, f->height, f->char_width ? name : "NULL", f->name);
+
+    if (f->guard[0]) {
+        fprintf(out, "#endif\n");
+    }
+    fprintf(out, "\n");
+
+    free(fixed);
+    free(trimmed);
+    return size;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "uso: %s <fonts.c> <saida.c>\n", argv[0]);
+        return 1;
+    }
+
+    srcparse_set_tool("fontpack");
+    char *src = srcparse_load(argv[1]);
+    parse(src);
+    if (font_count == 0) {
+        srcparse_die("nenhuma fonte encontrada em", argv[1]);
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out) {
+        srcparse_die("não foi possível criar", argv[2]);
+    }
+    fprintf(out, "/* Gerado por tools/fontpack a partir de %s. Não edite. */\n\n", argv[1]);
+    fprintf(out, "#include \"inc/fonts.h\"\n\n");
+
+    size_t total_before = 0, total_after = 0;
+    for (size_t i = 0; i < font_count; i++) {
+        const Font_t *f = &fonts[i];
+        size_t before = sizeof(uint16_t) * f->data->count +
+                        (f->char_width ? f->char_width->count : 0);
+        size_t after = emit_font(out, f);
+
+        printf("fontpack: %-11s %5zu -> %5zu bytes (%+.0f%%)\n", f->name, before, after,
+               100.0 * ((double)after - (double)before) / (double)before);
+        total_before += before;
+        total_after += after;
+    }
+    printf("fontpack: total       %5zu -> %5zu bytes de flash\n", total_before, total_after);
+
+    if (fclose(out) != 0) {
+        srcparse_die("falha ao gravar", argv[2]);
+    }
+    free(src);
+    return 0;
+}
@@ -0,0 +1,638 @@
+/**
+ * @file pagepack.c
+ * @brief Comprime as páginas de web/ em gzip, como vetores const para a flash.
+ *
+ * O servidor HTTP de src/wifi.c envia esses vetores como estão, com
+ * "Content-Encoding: gzip": a página não é formatada nem montada num buffer da
+ * aplicação a cada requisição. O lwIP ainda copia para o seu heap o que está
+ * na janela de envio (LWIP_NETIF_TX_SINGLE_PBUF, ver send_page). O deflate
+ * (LZ77 com cadeias de hash e códigos de Huffman dinâmicos, RFC 1951) fica
+ * aqui para as ferramentas não dependerem da zlib.
+ *
+ * Uso: pagepack <saida.c> [-D<NOME>=<valor> ...] <nome>=<arquivo> ...
+ *
+ * Cada -D troca "@NOME@" nas páginas pelo valor (o tamanho do display, por
+ * exemplo). Cada página gera "const WEB_Page_t web_page_<nome>", com o tipo do
+ * conteúdo deduzido da extensão do arquivo.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srcparse.h"
+
+#define MAX_DEFINES     16
+
+#define WINDOW_SIZE     32768
+#define MIN_MATCH       3
+#define MAX_MATCH       258
+#define MAX_CHAIN       4096    // Candidatos testados por posição
+#define TOO_FAR         4096    // Distância a partir da qual um match de 3 não compensa
+#define HASH_BITS       15
+#define HASH_SIZE       (1u << HASH_BITS)
+
+#define LITLEN_CODES    286
+#define DIST_CODES      30
+#define CLEN_CODES      19
+#define MAX_BITS        15
+#define MAX_CLEN_BITS   7
+
+/* Troca "@nome@" por value */
+typedef struct {
+    char name[SRCPARSE_NAME_LEN];
+    const char *value;
+} Define_t;
+
+static Define_t defines[MAX_DEFINES];
+static size_t define_count = 0;
+
+/* Vetor de bytes que cresce conforme a escrita */
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t cap;
+} Buffer_t;
+
+/* Literal (dist == 0) ou par comprimento/distância do LZ77 */
+typedef struct {
+    uint16_t value;
+    uint16_t dist;
+} Token_t;
+
+/* Escrita de bits do deflate: do bit menos significativo para o mais */
+typedef struct {
+    Buffer_t *out;
+    uint32_t bits;
+    unsigned count;
+} BitWriter_t;
+
+static const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t clen_order[CLEN_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+static void buffer_put(Buffer_t *b, const void *data, size_t len) {
+    if (b->len + len > b->cap) {
+        b->cap = (b->len + len) * 2;
+        b->data = realloc(b->data, b->cap);
+        if (!b->data) {
+            srcparse_die("sem memória", NULL);
+        }
+    }
+    memcpy(&b->data[b->len], data, len);
+    b->len += len;
+}
+
+static void buffer_byte(Buffer_t *b, uint8_t value) {
+    buffer_put(b, &value, 1);
+}
+
+static void buffer_le32(Buffer_t *b, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buffer_byte(b, (uint8_t)(value >> (8 * i)));
+    }
+}
+
+static void put_bits(BitWriter_t *bw, uint32_t value, unsigned n) {
+    bw->bits |= value << bw->count;
+    bw->count += n;
+    while (bw->count >= 8) {
+        buffer_byte(bw->out, (uint8_t)bw->bits);
+        bw->bits >>= 8;
+        bw->count -= 8;
+    }
+}
+
+static void flush_bits(BitWriter_t *bw) {
+    if (bw->count > 0) {
+        buffer_byte(bw->out, (uint8_t)bw->bits);
+    }
+    bw->bits = 0;
+    bw->count = 0;
+}
+
+/**
+ * @brief Lê o arquivo inteiro (sem tirar comentários, ao contrário de srcparse_load).
+ *
+ */
+static void load_file(const char *path, Buffer_t *b) {
+    FILE *f = fopen(path, "rb");
+    uint8_t chunk[4096];
+    size_t n;
+
+    if (!f) {
+        srcparse_die("não foi possível abrir", path);
+    }
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        buffer_put(b, chunk, n);
+    }
+    fclose(f);
+}
+
+/**
+ * @brief Troca cada "@NOME@" de um -D pelo valor; um "@NOME@" sem -D é erro.
+ *
+ */
+static void substitute(const Buffer_t *in, Buffer_t *out, const char *path) {
+    size_t i = 0;
+
+    while (i < in->len) {
+        size_t end = i + 1;
+        if (in->data[i] == '@') {
+            while (end < in->len && (in->data[end] == '_' || (in->data[end] >= 'A' && in->data[end] <= 'Z') ||
+                                     (in->data[end] >= '0' && in->data[end] <= '9'))) {
+                end++;
+            }
+        }
+        if (in->data[i] != '@' || end == i + 1 || end >= in->len || in->data[end] != '@') {
+            buffer_byte(out, in->data[i++]);
+            continue;
+        }
+
+        const size_t name_len = end - i - 1;
+        size_t d;
+        for (d = 0; d < define_count; d++) {
+            if (strlen(defines[d].name) == name_len && memcmp(defines[d].name, &in->data[i + 1], name_len) == 0) {
+                break;
+            }
+        }
+        if (d == define_count) {
+            srcparse_die("marcador @...@ sem -D correspondente", path);
+        }
+        buffer_put(out, defines[d].value, strlen(defines[d].value));
+        i = end + 1;
+    }
+}
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t hash3(const uint8_t *p) {
+    return ((uint32_t)p[0] << 10 ^ (uint32_t)p[1] << 5 ^ p[2]) & (HASH_SIZE - 1);
+}
+
+/**
+ * @brief Separa a entrada em literais e pares comprimento/distância (LZ77).
+ *
+ * Cadeias de hash de 3 bytes sobre a janela de 32 KB, com avaliação
+ * preguiçosa: se a posição seguinte tem um match maior, a atual sai como
+ * literal.
+ *
+ * @return Quantidade de tokens escritos em tokens (no máximo len).
+ */
+static size_t lz77(const uint8_t *data, size_t len, Token_t *tokens) {
+    int32_t *head = malloc(HASH_SIZE * sizeof(int32_t));
+    int32_t *prev = malloc((len ? len : 1) * sizeof(int32_t));
+    size_t inserted = 0;
+    size_t count = 0;
+    size_t i = 0;
+
+    if (!head || !prev) {
+        srcparse_die("sem memória", NULL);
+    }
+    for (size_t h = 0; h < HASH_SIZE; h++) {
+        head[h] = -1;
+    }
+
+    while (i < len) {
+        unsigned best[2] = {0, 0};
+        unsigned best_dist[2] = {0, 0};
+
+        // Posição atual (k = 0) e a seguinte (k = 1), para a avaliação preguiçosa
+        for (unsigned k = 0; k < 2 && i + k + MIN_MATCH <= len; k++) {
+            const size_t pos = i + k;
+            const size_t max = (len - pos < MAX_MATCH) ? len - pos : MAX_MATCH;
+
+            for (; inserted < pos; inserted++) {
+                if (inserted + MIN_MATCH <= len) {
+                    const uint32_t h = hash3(&data[inserted]);
+                    prev[inserted] = head[h];
+                    head[h] = (int32_t)inserted;
+                }
+            }
+
+            int32_t cand = head[hash3(&data[pos])];
+            for (unsigned chain = 0; cand >= 0 && pos - (size_t)cand <= WINDOW_SIZE && chain < MAX_CHAIN; chain++) {
+                const uint8_t *a = &data[cand];
+                const uint8_t *b = &data[pos];
+                if (a[best[k]] == b[best[k]]) {
+                    unsigned n = 0;
+                    while (n < max && a[n] == b[n]) {
+                        n++;
+                    }
+                    if (n > best[k]) {
+                        best[k] = n;
+                        best_dist[k] = (unsigned)(pos - (size_t)cand);
+                        if (n == max) {
+                            break;
+                        }
+                    }
+                }
+                cand = prev[cand];
+            }
+            if (best[k] < MIN_MATCH || (best[k] == MIN_MATCH && best_dist[k] > TOO_FAR)) {
+                best[k] = 0;
+            }
+            if (best[k] == 0) {
+                break;  // Sem match aqui: a posição seguinte não muda a decisão
+            }
+        }
+
+        if (best[0] == 0 || best[1] > best[0]) {
+            tokens[count++] = (Token_t){data[i], 0};
+            i++;
+        } else {
+            tokens[count++] = (Token_t){(uint16_t)best[0], (uint16_t)best_dist[0]};
+            i += best[0];
+        }
+    }
+
+    free(head);
+    free(prev);
+    return count;
+}
+
+/**
+ * @brief Calcula os comprimentos dos códigos de Huffman, limitados a limit bits.
+ *
+ * Se a árvore passar do limite, as frequências são reduzidas pela metade
+ * (sem zerar nenhuma) e a árvore é refeita. Com um único símbolo usado, ele e
+ * outro ganham 1 bit, já que o deflate não aceita um código sozinho de 0 bits.
+ */
+static void huffman_lengths(const uint32_t *freq, unsigned n, unsigned limit, uint8_t *lengths) {
+    uint32_t weight[2 * LITLEN_CODES];
+    int parent[2 * LITLEN_CODES];
+    bool done[2 * LITLEN_CODES];
+    uint32_t scaled[LITLEN_CODES];
+    unsigned used = 0;
+
+    memset(lengths, 0, n);
+    for (unsigned s = 0; s < n; s++) {
+        scaled[s] = freq[s];
+        used += (freq[s] > 0);
+    }
+    if (used < 2) {
+        for (unsigned s = 0; s < n && used < 2; s++) {
+            if (freq[s] == 0) {
+                lengths[s] = 1;
+                used++;
+            }
+        }
+        for (unsigned s = 0; s < n; s++) {
+            lengths[s] |= (freq[s] > 0);
+        }
+        return;
+    }
+
+    while (1) {
+        unsigned nodes = n;
+        unsigned deepest = 0;
+
+        for (unsigned s = 0; s < n; s++) {
+            weight[s] = scaled[s];
+            parent[s] = -1;
+            done[s] = (scaled[s] == 0);
+        }
+
+        // Junta os dois nós de menor peso até sobrar a raiz
+        for (unsigned joins = 1; joins < used; joins++) {
+            int lo[2] = {-1, -1};
+            for (unsigned s = 0; s < nodes; s++) {
+                if (done[s]) {
+                    continue;
+                }
+                if (lo[0] < 0 || weight[s] < weight[lo[0]]) {
+                    lo[1] = lo[0];
+                    lo[0] = (int)s;
+                } else if (lo[1] < 0 || weight[s] < weight[lo[1]]) {
+                    lo[1] = (int)s;
+                }
+            }
+            weight[nodes] = weight[lo[0]] + weight[lo[1]];
+            parent[nodes] = -1;
+            done[nodes] = false;
+            parent[lo[0]] = parent[lo[1]] = (int)nodes;
+            done[lo[0]] = done[lo[1]] = true;
+            nodes++;
+        }
+
+        for (unsigned s = 0; s < n; s++) {
+            unsigned depth = 0;
+            if (scaled[s] > 0) {
+                for (int p = parent[s]; p >= 0; p = parent[p]) {
+                    depth++;
+                }
+            }
+            lengths[s] = (uint8_t)depth;
+            deepest = (depth > deepest) ? depth : deepest;
+        }
+        if (deepest <= limit) {
+            return;
+        }
+        for (unsigned s = 0; s < n; s++) {
+            scaled[s] = scaled[s] ? (scaled[s] >> 1) | 1 : 0;
+        }
+    }
+}
+
+/**
+ * @brief Gera os códigos canônicos (RFC 1951, 3.2.2), já invertidos para a escrita LSB primeiro.
+ *
+ */
+static void huffman_codes(const uint8_t *lengths, unsigned n, uint16_t *codes) {
+    unsigned count[MAX_BITS + 1] = {0};
+    unsigned next[MAX_BITS + 1];
+    unsigned code = 0;
+
+    for (unsigned s = 0; s < n; s++) {
+        count[lengths[s]]++;
+    }
+    count[0] = 0;
+    for (unsigned bits = 1; bits <= MAX_BITS; bits++) {
+        code = (code + count[bits - 1]) << 1;
+        next[bits] = code;
+    }
+    for (unsigned s = 0; s < n; s++) {
+        const unsigned len = lengths[s];
+        codes[s] = 0;
+        if (len == 0) {
+            continue;
+        }
+        unsigned c = next[len]++;
+        for (unsigned b = 0; b < len; b++) {
+            codes[s] = (uint16_t)((codes[s] << 1) | (c & 1));
+            c >>= 1;
+        }
+    }
+}
+
+static unsigned find_code(const uint16_t *base, unsigned n, unsigned value) {
+    unsigned code = 0;
+    while (code + 1 < n && base[code + 1] <= value) {
+        code++;
+    }
+    return code;
+}
+
+/**
+ * @brief Comprime data num único bloco deflate com códigos de Huffman dinâmicos.
+ *
+ */
+static void deflate(const uint8_t *data, size_t len, Buffer_t *out) {
+    Token_t *tokens = malloc((len ? len : 1) * sizeof(Token_t));
+    uint32_t litlen_freq[LITLEN_CODES] = {0};
+    uint32_t dist_freq[DIST_CODES] = {0};
+    uint32_t clen_freq[CLEN_CODES] = {0};
+    uint8_t litlen_len[LITLEN_CODES], dist_len[DIST_CODES], clen_len[CLEN_CODES];
+    uint16_t litlen_code[LITLEN_CODES], dist_code[DIST_CODES], clen_code[CLEN_CODES];
+    BitWriter_t bw = {out, 0, 0};
+
+    if (!tokens) {
+        srcparse_die("sem memória", NULL);
+    }
+    const size_t count = lz77(data, len, tokens);
+
+    for (size_t t = 0; t < count; t++) {
+        if (tokens[t].dist == 0) {
+            litlen_freq[tokens[t].value]++;
+        } else {
+            litlen_freq[257 + find_code(length_base, 29, tokens[t].value)]++;
+            dist_freq[find_code(dist_base, 30, tokens[t].dist)]++;
+        }
+    }
+    litlen_freq[256] = 1;
+
+    huffman_lengths(litlen_freq, LITLEN_CODES, MAX_BITS, litlen_len);
+    huffman_lengths(dist_freq, DIST_CODES, MAX_BITS, dist_len);
+    huffman_codes(litlen_len, LITLEN_CODES, litlen_code);
+    huffman_codes(dist_len, DIST_CODES, dist_code);
+
+    unsigned hlit = LITLEN_CODES;
+    unsigned hdist = DIST_CODES;
+    while (hlit > 257 && litlen_len[hlit - 1] == 0) {
+        hlit--;
+    }
+    while (hdist > 1 && dist_len[hdist - 1] == 0) {
+        hdist--;
+    }
+
+    // Comprimentos das duas tabelas em sequência, com as repetições 16/17/18
+    uint8_t lens[LITLEN_CODES + DIST_CODES];
+    uint8_t rle[LITLEN_CODES + DIST_CODES][2];  // símbolo, bits extras
+    unsigned rle_count = 0;
+    const unsigned total = hlit + hdist;
+
+    memcpy(lens, litlen_len, hlit);
+    memcpy(&lens[hlit], dist_len, hdist);
+    for (unsigned i = 0; i < total;) {
+        const uint8_t cur = lens[i];
+        unsigned run = 1;
+        while (i + run < total && lens[i + run] == cur) {
+            run++;
+        }
+        i += run;
+
+        if (cur == 0) {
+            while (run >= 11) {
+                const unsigned n = (run < 138) ? run : 138;
+                rle[rle_count][0] = 18;
+                rle[rle_count++][1] = (uint8_t)(n - 11);
+                run -= n;
+            }
+            if (run >= 3) {
+                rle[rle_count][0] = 17;
+                rle[rle_count++][1] = (uint8_t)(run - 3);
+                run = 0;
+            }
+        } else {
+            rle[rle_count][0] = cur;
+            rle[rle_count++][1] = 0;
+            run--;
+            while (run >= 3) {
+                const unsigned n = (run < 6) ? run : 6;
+                rle[rle_count][0] = 16;
+                rle[rle_count++][1] = (uint8_t)(n - 3);
+                run -= n;
+            }
+        }
+        while (run > 0) {
+            rle[rle_count][0] = cur;
+            rle[rle_count++][1] = 0;
+            run--;
+        }
+    }
+
+    for (unsigned r = 0; r < rle_count; r++) {
+        clen_freq[rle[r][0]]++;
+    }
+    huffman_lengths(clen_freq, CLEN_CODES, MAX_CLEN_BITS, clen_len);
+    huffman_codes(clen_len, CLEN_CODES, clen_code);
+
+    unsigned hclen = CLEN_CODES;
+    while (hclen > 4 && clen_len[clen_order[hclen - 1]] == 0) {
+        hclen--;
+    }
+
+    // Cabeçalho do bloco: BFINAL = 1, BTYPE = 2 (Huffman dinâmico)
+    put_bits(&bw, 1, 1);
+    put_bits(&bw, 2, 2);
+    put_bits(&bw, hlit - 257, 5);
+    put_bits(&bw, hdist - 1, 5);
+    put_bits(&bw, hclen - 4, 4);
+    for (unsigned i = 0; i < hclen; i++) {
+        put_bits(&bw, clen_len[clen_order[i]], 3);
+    }
+    for (unsigned r = 0; r < rle_count; r++) {
+        const uint8_t sym = rle[r][0];
+        put_bits(&bw, clen_code[sym], clen_len[sym]);
+        if (sym == 16) {
+            put_bits(&bw, rle[r][1], 2);
+        } else if (sym == 17) {
+            put_bits(&bw, rle[r][1], 3);
+        } else if (sym == 18) {
+            put_bits(&bw, rle[r][1], 7);
+        }
+    }
+
+    for (size_t t = 0; t < count; t++) {
+        if (tokens[t].dist == 0) {
+            put_bits(&bw, litlen_code[tokens[t].value], litlen_len[tokens[t].value]);
+            continue;
+        }
+        const unsigned lc = find_code(length_base, 29, tokens[t].value);
+        const unsigned dc = find_code(dist_base, 30, tokens[t].dist);
+        put_bits(&bw, litlen_code[257 + lc], litlen_len[257 + lc]);
+        put_bits(&bw, tokens[t].value - length_base[lc], length_extra[lc]);
+        put_bits(&bw, dist_code[dc], dist_len[dc]);
+        put_bits(&bw, tokens[t].dist - dist_base[dc], dist_extra[dc]);
+    }
+    put_bits(&bw, litlen_code[256], litlen_len[256]);
+    flush_bits(&bw);
+
+    free(tokens);
+}
+
+/**
+ * @brief Monta o arquivo gzip (RFC 1952) da página.
+ *
+ * Sem nome de arquivo nem data no cabeçalho, para a saída ser sempre a mesma
+ * para as mesmas páginas.
+ */
+static void gzip(const Buffer_t *in, Buffer_t *out) {
+    static const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 2, 0xFF};
+
+    buffer_put(out, header, sizeof(header));
+    deflate(in->data, in->len, out);
+    buffer_le32(out, crc32(in->data, in->len));
+    buffer_le32(out, (uint32_t)in->len);
+}
+
+static const char* content_type(const char *path) {
+    static const char *types[][2] = {
+        {".html", "text/html; charset=UTF-8"},
+        {".css", "text/css"},
+        {".js", "application/javascript"},
+        {".svg", "image/svg+xml"},
+        {".json", "application/json"},
+    };
+    const char *ext = strrchr(path, '.');
+
+    for (size_t i = 0; ext && i < sizeof(types) / sizeof(types[0]); i++) {
+        if (strcmp(ext, types[i][0]) == 0) {
+            return types[i][1];
+        }
+    }
+    srcparse_die("extensão sem tipo de conteúdo conhecido", path);
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    srcparse_set_tool("pagepack");
+    if (argc < 3) {
+        fprintf(stderr, "uso: %s <saida.c> [-D<NOME>=<valor> ...] <nome>=<arquivo> ...\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 2; i < argc; i++) {
+        const char *eq = strchr(argv[i], '=');
+        if (strncmp(argv[i], "-D", 2) != 0) {
+            continue;
+        }
+        if (!eq || eq - argv[i] - 2 <= 0 || eq - argv[i] - 2 >= SRCPARSE_NAME_LEN || define_count >= MAX_DEFINES) {
+            srcparse_die("definição inválida (-DNOME=valor)", argv[i]);
+        }
+        memcpy(defines[define_count].name, argv[i] + 2, (size_t)(eq - argv[i] - 2));
+        defines[define_count].name[eq - argv[i] - 2] = '\0';
+        defines[define_count++].value = eq + 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out) {
+        srcparse_die("não foi possível criar", argv[1]);
+    }
+    fprintf(out, "/* Gerado por tools/pagepack a partir de web/. Não edite. */\n\n");
+    fprintf(out, "#include \"inc/webpages.h\"\n\n");
+
+    for (int i = 2; i < argc; i++) {
+        char name[SRCPARSE_NAME_LEN];
+        Buffer_t raw = {0}, page = {0}, gz = {0};
+        int name_len = 0;
+
+        if (strncmp(argv[i], "-D", 2) == 0) {
+            continue;
+        }
+        if (sscanf(argv[i], "%63[A-Za-z0-9_]%n", name, &name_len) != 1 || argv[i][name_len] != '=') {
+            srcparse_die("especificação inválida (nome=arquivo)", argv[i]);
+        }
+        const char *path = &argv[i][name_len + 1];
+
+        load_file(path, &raw);
+        substitute(&raw, &page, path);
+        gzip(&page, &gz);
+
+        fprintf(out, "static const uint8_t web_page_%s_gz[] = {", name);
+        for (size_t b = 0; b < gz.len; b++) {
+            fputs((b % 16) ? " " : "\n    ", out);
+            fprintf(out, "0x%02X,", gz.data[b]);
+        }
+        fprintf(out, "\n};\n");
+        fprintf(out, "const WEB_Page_t web_page_%s = {web_page_%s_gz, sizeof(web_page_%s_gz), \"%s\"};\n\n",
+                name, name, name, content_type(path));
+
+        printf("pagepack: %s %zu -> %zu bytes\n", name, page.len, gz.len);
+        free(raw.data);
+        free(page.data);
+        free(gz.data);
+    }
+
+    if (fclose(out) != 0) {
+        srcparse_die("falha ao gravar", argv[1]);
+    }
+    return 0;
+}
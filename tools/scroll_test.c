@@ -0,0 +1,141 @@
+/**
+ * @file scroll_test.c
+ * @brief Confere que nenhum flush escreve na GDDRAM com o scroll por hardware ligado.
+ *
+ * Repete o laço de WIFI_status (src/wifi.c) no display do host: tela inteira
+ * redesenhada a cada frame, com o SSID num letreiro curto (scroll por
+ * hardware). Enquanto só a faixa do letreiro "muda", nada é enviado e o scroll
+ * continua; quando o resto da tela muda (RSSI), o flush tem que desligar o
+ * scroll antes de escrever e o letreiro passa a rolar por software. O painel
+ * emulado conta os dados recebidos com o scroll ligado (scroll_writes), que
+ * têm que ficar em zero. Enquanto o hardware gira a faixa, o buffer (lido
+ * por ssd1306_ReadRow para o espelho e o SSE) tem que continuar com o texto
+ * do letreiro, mesmo com a tela apagada a cada frame. Também cobre ssd1306_ScrollHorizontal e
+ * ssd1306_ScrollDiagonal chamados direto. Retorna 1 se algum caso falhar.
+ *
+ * Uso: scroll_test
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "inc/display.h"
+#include "inc/fonts.h"
+
+static SSD1306_t panel;
+static int failures = 0;
+
+static const SSD1306_HostState_t* host(void) {
+    ssd1306_HostSelect(panel.I2c, panel.Address);
+    return ssd1306_HostState();
+}
+
+static void check(const char* what, bool ok) {
+    printf("%-58s %s\n", what, ok ? "ok" : "FALHOU");
+    failures += !ok;
+}
+
+/* O painel emulado mostra o buffer inteiro */
+static bool panel_matches(void) {
+    uint8_t row[SSD1306_MAX_WIDTH / 8];
+
+    host();
+    for (uint8_t y = 0; y < panel.Height; y++) {
+        ssd1306_ReadRow(y, row);
+        for (uint8_t x = 0; x < panel.Width; x++) {
+            if (((row[x / 8] >> (7 - x % 8)) & 1) != ssd1306_HostPixel(x, y)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Linhas da faixa do letreiro (páginas 5 e 6) como ssd1306_ReadRow as entrega */
+static void read_band(uint8_t rows[16][SSD1306_MAX_WIDTH / 8]) {
+    for (uint8_t y = 0; y < 16; y++) {
+        ssd1306_ReadRow(40 + y, rows[y]);
+    }
+}
+
+/* Um frame de WIFI_status com o RSSI dado */
+static void wifi_frame(int rssi, bool start_marquee) {
+    static char marquee[] = "SSID: PicoEdu";
+    char status[32];
+
+    ssd1306_Fill(White);
+    ssd1306_SetCursor(0, 0);
+    ssd1306_WriteString("WiFi: Conectado", Font_7x10, Black);
+    ssd1306_SetCursor(0, 24);
+    snprintf(status, sizeof(status), "Sinal: %d dBm", rssi);
+    ssd1306_WriteString(status, Font_7x10, Black);
+    ssd1306_SetCursor(0, 56);
+    ssd1306_WriteString("MAC: 28:CD:C1:00:00:01", Font_6x8, Black);
+    if (start_marquee) {
+        ssd1306_Marquee(marquee, &Font_7x10, 5, Black, SSD1306_SCROLL_2_FRAMES);
+    }
+    ssd1306_MarqueeTick();
+    ssd1306_UpdateScreenAsync();
+}
+
+int main(void) {
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .rotation = SSD1306_ROTATE_0,
+    };
+
+    static uint8_t band[16][SSD1306_MAX_WIDTH / 8], now[16][SSD1306_MAX_WIDTH / 8];
+
+    ssd1306_InitDisplay(&panel, &config);
+    ssd1306_Select(&panel);
+
+    wifi_frame(-60, true);
+    check("letreiro curto: scroll por hardware ligado", host()->scroll_active);
+    read_band(band);
+
+    wifi_frame(-60, false);
+    wifi_frame(-60, false);
+    check("tela igual: nada enviado, scroll continua",
+          panel.Stats.last_sent == 0 && host()->scroll_active);
+    read_band(now);
+    check("scroll por hardware: ReadRow mostra o letreiro na faixa",
+          memcmp(band, now, sizeof(band)) == 0);
+
+    wifi_frame(-61, false);
+    check("RSSI mudou: scroll desligado antes do envio", !host()->scroll_active);
+    check("RSSI mudou: painel igual ao buffer (letreiro por software)", panel_matches());
+    for (int i = 0; i < 20; i++) {
+        wifi_frame(-61 - i % 3, false);
+    }
+    check("letreiro por software: painel igual ao buffer", panel_matches());
+    check("nenhum dado escrito com o scroll ligado", host()->scroll_writes == 0);
+
+    // Scroll chamado direto, sem letreiro
+    ssd1306_MarqueeStop();
+    ssd1306_Fill(Black);
+    ssd1306_SetCursor(0, 0);
+    ssd1306_WriteString("rolando", Font_7x10, White);
+    ssd1306_ScrollHorizontal(SSD1306_SCROLL_LEFT, 0, 1, SSD1306_SCROLL_5_FRAMES);
+    ssd1306_FillRectangle(0, 40, 50, 50, White);
+    ssd1306_UpdateScreen();
+    check("ScrollHorizontal + desenho fora da faixa: scroll desligado",
+          !host()->scroll_active && !panel.ScrollActive && panel_matches());
+
+    ssd1306_ScrollDiagonal(SSD1306_SCROLL_RIGHT, 0, 1, SSD1306_SCROLL_5_FRAMES, 1);
+    ssd1306_FillRectangle(60, 40, 80, 50, White);
+    ssd1306_UpdateScreenAsync();
+    check("ScrollDiagonal + desenho fora da faixa: scroll desligado",
+          !host()->scroll_active && panel_matches());
+
+    ssd1306_ScrollHorizontal(SSD1306_SCROLL_LEFT, 0, 1, SSD1306_SCROLL_5_FRAMES);
+    ssd1306_FillRectangle(0, 0, 10, 10, Black);
+    ssd1306_UpdateScreen();
+    check("desenho só na faixa: scroll continua, nada enviado",
+          host()->scroll_active && panel.Stats.last_sent == 0);
+    check("nenhum dado escrito com o scroll ligado (total)", host()->scroll_writes == 0);
+
+    return failures ? 1 : 0;
+}
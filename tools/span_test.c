@@ -0,0 +1,203 @@
+/**
+ * @file span_test.c
+ * @brief Confere que os caminhos por faixas desenham os mesmos pixels que os de antes.
+ *
+ * As referências são as implementações originais, ponto a ponto sobre
+ * ssd1306_DrawPixel: FillRectangle com dois laços, HLine/VLine/DrawRectangle
+ * com o Bresenham de ssd1306_Line e Fill pixel a pixel. Cada primitiva roda com
+ * coordenadas pseudoaleatórias (inclusive fora da tela e invertidas), nas duas
+ * cores e nas quatro rotações, sobre um fundo com pixels dos dois tons; o
+ * buffer tem que sair igual ao da referência e toda coluna alterada tem que
+ * estar marcada para o próximo flush. Retorna 1 se algum caso falhar.
+ *
+ * Uso: span_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "inc/display.h"
+
+#define CASES   4000
+
+static SSD1306_t panel;
+static uint8_t expected[SSD1306_MAX_BUFFER_SIZE];
+static uint8_t background[SSD1306_MAX_BUFFER_SIZE];
+static uint32_t seed = 12345;
+
+static uint8_t random_coord(void) {
+    seed = seed * 1103515245u + 12345u;
+    uint8_t v = (seed >> 16) & 0xFF;
+    // Quase sempre dentro da tela; às vezes fora, para testar o recorte
+    return ((seed >> 8) & 7) ? v % 140 : v;
+}
+
+/* ssd1306_Line de antes (Bresenham, um ssd1306_DrawPixel por ponto) */
+static void ref_Line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    int32_t deltaX = abs(x2 - x1);
+    int32_t deltaY = abs(y2 - y1);
+    int32_t signX = ((x1 < x2) ? 1 : -1);
+    int32_t signY = ((y1 < y2) ? 1 : -1);
+    int32_t error = deltaX - deltaY;
+    int32_t error2;
+
+    ssd1306_DrawPixel(x2, y2, color);
+    while ((x1 != x2) || (y1 != y2)) {
+        ssd1306_DrawPixel(x1, y1, color);
+        error2 = error * 2;
+        if (error2 > -deltaY) {
+            error -= deltaY;
+            x1 += signX;
+        }
+        if (error2 < deltaX) {
+            error += deltaX;
+            y1 += signY;
+        }
+    }
+}
+
+static void ref_DrawRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    ref_Line(x1, y1, x2, y1, color);
+    ref_Line(x2, y1, x2, y2, color);
+    ref_Line(x2, y2, x1, y2, color);
+    ref_Line(x1, y2, x1, y1, color);
+}
+
+static void ref_FillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    uint8_t x_start = ((x1 <= x2) ? x1 : x2);
+    uint8_t x_end   = ((x1 <= x2) ? x2 : x1);
+    uint8_t y_start = ((y1 <= y2) ? y1 : y2);
+    uint8_t y_end   = ((y1 <= y2) ? y2 : y1);
+
+    for (uint16_t y = y_start; (y <= y_end) && (y < ssd1306_GetHeight()); y++) {
+        for (uint16_t x = x_start; (x <= x_end) && (x < ssd1306_GetWidth()); x++) {
+            ssd1306_DrawPixel(x, y, color);
+        }
+    }
+}
+
+static void ref_Fill(SSD1306_COLOR color) {
+    for (uint16_t y = 0; y < ssd1306_GetHeight(); y++) {
+        for (uint16_t x = 0; x < ssd1306_GetWidth(); x++) {
+            ssd1306_DrawPixel(x, y, color);
+        }
+    }
+}
+
+typedef enum { OP_FILL_RECT, OP_DRAW_RECT, OP_HLINE, OP_VLINE, OP_LINE, OP_FILL, OP_COUNT } Op_t;
+
+static const char* const OpNames[OP_COUNT] = {
+    "FillRectangle", "DrawRectangle", "HLine", "VLine", "Line (eixos)", "Fill"
+};
+
+static void run(Op_t op, int reference, const uint8_t* c, SSD1306_COLOR color) {
+    switch (op) {
+        case OP_FILL_RECT:
+            (reference ? ref_FillRectangle : ssd1306_FillRectangle)(c[0], c[1], c[2], c[3], color);
+            break;
+        case OP_DRAW_RECT:
+            (reference ? ref_DrawRectangle : ssd1306_DrawRectangle)(c[0], c[1], c[2], c[3], color);
+            break;
+        case OP_HLINE:
+            if (reference) {
+                ref_Line(c[0], c[1], c[2], c[1], color);
+            } else {
+                ssd1306_HLine(c[0], c[2], c[1], color);
+            }
+            break;
+        case OP_VLINE:
+            if (reference) {
+                ref_Line(c[0], c[1], c[0], c[3], color);
+            } else {
+                ssd1306_VLine(c[0], c[1], c[3], color);
+            }
+            break;
+        case OP_LINE:
+            // Linhas horizontais e verticais pegam o atalho de ssd1306_Line
+            if (c[4] & 1) {
+                (reference ? ref_Line : ssd1306_Line)(c[0], c[1], c[2], c[1], color);
+            } else {
+                (reference ? ref_Line : ssd1306_Line)(c[0], c[1], c[0], c[3], color);
+            }
+            break;
+        case OP_FILL:
+            if (reference) {
+                ref_Fill(color);
+            } else {
+                ssd1306_Fill(color);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* Toda coluna que mudou está dentro da faixa suja da sua página */
+static int dirty_covers(size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (panel.Buffer[i] != background[i]) {
+            uint8_t page = i / panel.Width, x = i % panel.Width;
+            if (x < panel.DirtyStart[page] || x > panel.DirtyEnd[page]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .rotation = SSD1306_ROTATE_0,
+    };
+    uint32_t failures[OP_COUNT] = { 0 };
+    int failed = 0;
+
+    ssd1306_InitDisplay(&panel, &config);
+    ssd1306_Select(&panel);
+    const size_t size = panel.Width * panel.Pages;
+
+    for (int rotation = SSD1306_ROTATE_0; rotation <= SSD1306_ROTATE_270; rotation++) {
+        ssd1306_SetRotation((SSD1306_Rotation_t)rotation);
+        for (Op_t op = 0; op < OP_COUNT; op++) {
+            const uint32_t cases = (op == OP_FILL) ? 4 : CASES;
+            for (uint32_t n = 0; n < cases; n++) {
+                uint8_t c[5];
+                for (int k = 0; k < 5; k++) {
+                    c[k] = random_coord();
+                }
+                const SSD1306_COLOR color = (n & 1) ? White : Black;
+                for (size_t i = 0; i < size; i++) {
+                    background[i] = (uint8_t)((i * 37 + n * 11) ^ (i >> 3));
+                }
+
+                memcpy(panel.Buffer, background, size);
+                run(op, 1, c, color);
+                memcpy(expected, panel.Buffer, size);
+
+                memcpy(panel.Buffer, background, size);
+                memset(panel.DirtyStart, 0xFF, sizeof(panel.DirtyStart));
+                memset(panel.DirtyEnd, 0x00, sizeof(panel.DirtyEnd));
+                run(op, 0, c, color);
+
+                if (memcmp(expected, panel.Buffer, size) != 0 || !dirty_covers(size)) {
+                    if (failures[op]++ == 0) {
+                        printf("%s, rotacao %d: (%u,%u)-(%u,%u) cor %d difere\n", OpNames[op],
+                               rotation * 90, c[0], c[1], c[2], c[3], color);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("primitiva        casos  falhas\n");
+    for (Op_t op = 0; op < OP_COUNT; op++) {
+        printf("%-15s %6u  %6u\n", OpNames[op], 4 * ((op == OP_FILL) ? 4 : CASES), failures[op]);
+        failed |= failures[op] != 0;
+    }
+    return failed;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file srcparse.c
+ * @brief Leitura das tabelas C do firmware (src/fonts.c, src/icons.c) pelas ferramentas do host.
+ */
+
+#include "srcparse.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *tool_name = "tools";
+
+void srcparse_set_tool(const char *name) {
+    tool_name = name;
+}
+
+void srcparse_die(const char *msg, const char *arg) {
+    fprintf(stderr, "%s: %s%s%s\n", tool_name, msg, arg ? ": " : "", arg ? arg : "");
+    exit(1);
+}
+
+char* srcparse_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        srcparse_die("não foi possível abrir", path);
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *src = malloc((size_t)size + 1);
+    if (!src || fread(src, 1, (size_t)size, f) != (size_t)size) {
+        srcparse_die("falha ao ler", path);
+    }
+    src[size] = '\0';
+    fclose(f);
+
+    for (char *p = src; *p; p++) {
+        if (p[0] == '/' && p[1] == '/') {
+            while (*p && *p != '\n') {
+                *p++ = ' ';
+            }
+            if (!*p) {
+                break;
+            }
+        } else if (p[0] == '/' && p[1] == '*') {
+            *p++ = ' ';
+            *p++ = ' ';
+            while (*p && !(p[0] == '*' && p[1] == '/')) {
+                if (*p != '\n') {
+                    *p = ' ';
+                }
+                p++;
+            }
+            if (!*p) {
+                break;
+            }
+            p[0] = p[1] = ' ';
+            p++;
+        }
+    }
+    return src;
+}
+
+const char* srcparse_skip_space(const char *p) {
+    while (isspace((unsigned char)*p)) {
+        p++;
+    }
+    return p;
+}
+
+const char* srcparse_ident(const char *p, char *out) {
+    size_t n = 0;
+    p = srcparse_skip_space(p);
+    while ((isalnum((unsigned char)*p) || *p == '_') && n + 1 < SRCPARSE_NAME_LEN) {
+        out[n++] = *p++;
+    }
+    out[n] = '\0';
+    return p;
+}
+
+const char* srcparse_values(const char *p, uint32_t **values, size_t *count, const char *what) {
+    size_t cap = 256;
+
+    p = strchr(p, '{');
+    if (!p) {
+        srcparse_die("tabela sem '{'", what);
+    }
+    p++;
+    *values = malloc(cap * sizeof(uint32_t));
+    *count = 0;
+    for (;;) {
+        char *end;
+        p = srcparse_skip_space(p);
+        if (*p == '}') {
+            return p + 1;
+        }
+        if (*p == ',') {
+            p++;
+            continue;
+        }
+        unsigned long v = strtoul(p, &end, 0);
+        if (end == p) {
+            srcparse_die("valor inválido na tabela", what);
+        }
+        if (*count == cap) {
+            cap *= 2;
+            *values = realloc(*values, cap * sizeof(uint32_t));
+        }
+        (*values)[(*count)++] = (uint32_t)v;
+        p = end;
+    }
+}
+
+const char* srcparse_next_line(const char *p) {
+    while (*p && *p != '\n') {
+        p++;
+    }
+    return *p ? p + 1 : p;
+}
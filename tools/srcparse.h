@@ -0,0 +1,34 @@
+/**
+ * @file srcparse.h
+ * @brief Leitura das tabelas C do firmware (src/fonts.c, src/icons.c) pelas ferramentas do host.
+ */
+
+#ifndef SRCPARSE_H
+#define SRCPARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SRCPARSE_NAME_LEN 64
+
+/* Termina o programa com uma mensagem "<ferramenta>: msg: arg" */
+void srcparse_die(const char *msg, const char *arg);
+
+/* Nome da ferramenta usado nas mensagens de erro */
+void srcparse_set_tool(const char *name);
+
+/* Lê o arquivo inteiro e apaga os comentários, preservando as quebras de linha */
+char* srcparse_load(const char *path);
+
+const char* srcparse_skip_space(const char *p);
+
+/* Copia um identificador C para out (SRCPARSE_NAME_LEN bytes) e retorna o ponteiro logo após ele */
+const char* srcparse_ident(const char *p, char *out);
+
+/* Lê a lista "{ v, v, ... }" que começa em p (ou adiante); retorna o ponteiro após o '}' */
+const char* srcparse_values(const char *p, uint32_t **values, size_t *count, const char *what);
+
+/* Avança p até o início da próxima linha */
+const char* srcparse_next_line(const char *p);
+
+#endif /* SRCPARSE_H */
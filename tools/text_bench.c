@@ -0,0 +1,230 @@
+/**
+ * @file text_bench.c
+ * @brief Texto antes e depois das fontes em colunas: tempo por string e conferência dos pixels.
+ *
+ * A referência é o ssd1306_WriteChar original: percorre as tabelas em linhas
+ * de src/fonts.c (incluído aqui com os nomes trocados) e chama
+ * ssd1306_DrawPixel para cada pixel do glifo, frente e fundo. Para cada fonte
+ * mede os dois caminhos na mesma string e, antes, confere que desenham os
+ * mesmos pixels para todos os caracteres, nas oito posições de Y dentro da
+ * página e nas duas cores. A mesma conferência roda em retrato (90 graus),
+ * com as fontes do projeto e com uma fonte de TALL_HEIGHT linhas, mais alta
+ * que o caminho girado aceita, em linhas e em colunas. Retorna 1 se algum
+ * pixel diferir.
+ *
+ * Uso: text_bench
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "inc/display.h"
+#include "inc/fonts.h"
+
+// Tabelas originais, em linhas, como Ref_Font_* (sem o campo packed)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#define Font_6x8    Ref_Font_6x8
+#define Font_7x10   Ref_Font_7x10
+#define Font_11x18  Ref_Font_11x18
+#define Font_16x26  Ref_Font_16x26
+#define Font_16x24  Ref_Font_16x24
+#define Font_16x15  Ref_Font_16x15
+#include "src/fonts.c"
+#undef Font_6x8
+#undef Font_7x10
+#undef Font_11x18
+#undef Font_16x26
+#undef Font_16x24
+#undef Font_16x15
+#pragma GCC diagnostic pop
+
+#define BENCH_MIN_US    100000
+#define TALL_WIDTH      12
+#define TALL_HEIGHT     40
+
+typedef struct {
+    const char *name;
+    const SSD1306_Font_t *font;
+    const SSD1306_Font_t *reference;
+} TextFont_t;
+
+static const TextFont_t Fonts[] = {
+    { "6x8",   &Font_6x8,   &Ref_Font_6x8 },
+    { "7x10",  &Font_7x10,  &Ref_Font_7x10 },
+    { "11x18", &Font_11x18, &Ref_Font_11x18 },
+    { "16x26", &Font_16x26, &Ref_Font_16x26 },
+    { "16x24", &Font_16x24, &Ref_Font_16x24 },
+    { "16x15", &Font_16x15, &Ref_Font_16x15 },
+};
+
+static SSD1306_t panel;
+
+// Fonte alta gerada aqui (não há nenhuma no projeto): em linhas e em colunas
+static uint16_t TallRows[95 * TALL_HEIGHT];
+static uint8_t TallColumns[95 * TALL_WIDTH * ((TALL_HEIGHT + 7) / 8)];
+static const SSD1306_PackedFont_t TallPacked = { TallColumns, NULL, NULL };
+static const SSD1306_Font_t TallRowFont = { TALL_WIDTH, TALL_HEIGHT, TallRows, NULL, NULL };
+static const SSD1306_Font_t TallPackedFont = { TALL_WIDTH, TALL_HEIGHT, TallRows, NULL, &TallPacked };
+
+static const TextFont_t TallFonts[] = {
+    { "12x40",   &TallRowFont,    &TallRowFont },
+    { "12x40 c", &TallPackedFont, &TallRowFont },
+};
+
+static void make_tall_font(void) {
+    const uint8_t pages = (TALL_HEIGHT + 7) / 8;
+    uint32_t seed = 77;
+
+    for (uint32_t g = 0; g < 95; g++) {
+        for (uint32_t r = 0; r < TALL_HEIGHT; r++) {
+            seed = seed * 1103515245u + 12345u;
+            const uint16_t line = (uint16_t)(seed >> 12) & (uint16_t)(0xFFFF << (16 - TALL_WIDTH));
+            TallRows[g * TALL_HEIGHT + r] = line;
+            for (uint32_t c = 0; c < TALL_WIDTH; c++) {
+                if ((line << c) & 0x8000) {
+                    TallColumns[(g * pages + r / 8) * TALL_WIDTH + c] |= 1 << (r % 8);
+                }
+            }
+        }
+    }
+}
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+/* ssd1306_WriteChar/WriteString de antes, pixel a pixel */
+static char ref_WriteChar(char ch, const SSD1306_Font_t* Font, SSD1306_COLOR color) {
+    if (ch < 32 || ch > 126) {
+        return 0;
+    }
+    if (ssd1306_GetWidth() < (panel.CurrentX + Font->width) ||
+        ssd1306_GetHeight() < (panel.CurrentY + Font->height)) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < Font->height; i++) {
+        uint32_t b = Font->data[(ch - 32) * Font->height + i];
+        for (uint32_t j = 0; j < Font->width; j++) {
+            ssd1306_DrawPixel(panel.CurrentX + j, panel.CurrentY + i,
+                              ((b << j) & 0x8000) ? color : (SSD1306_COLOR)!color);
+        }
+    }
+    panel.CurrentX += Font->char_width ? Font->char_width[ch - 32] : Font->width;
+    return ch;
+}
+
+static char ref_WriteString(char* str, const SSD1306_Font_t* Font, SSD1306_COLOR color) {
+    while (*str) {
+        if (ref_WriteChar(*str, Font, color) != *str) {
+            return *str;
+        }
+        str++;
+    }
+    return *str;
+}
+
+/* Os dois caminhos desenham os mesmos pixels (fundo com pixels dos dois tons) */
+static int check_font(const TextFont_t* f) {
+    static uint8_t expected[SSD1306_MAX_BUFFER_SIZE];
+    const size_t size = panel.Width * panel.Pages;
+    char text[SSD1306_MAX_WIDTH + 1];
+    int failures = 0;
+
+    for (int first = 32; first <= 126; first += 4) {
+        size_t len = 0;
+        for (int ch = first; ch <= 126 && len < 4; ch++) {
+            text[len++] = (char)ch;
+        }
+        text[len] = '\0';
+
+        for (uint8_t y = 0; y < 8; y++) {
+            for (int color = 0; color < 2; color++) {
+                for (int pass = 0; pass < 2; pass++) {
+                    for (size_t i = 0; i < size; i++) {
+                        panel.Buffer[i] = (uint8_t)(i * 37 + 11);
+                    }
+                    ssd1306_SetCursor(3, y);
+                    if (pass == 0) {
+                        ref_WriteString(text, f->reference, (SSD1306_COLOR)color);
+                        memcpy(expected, panel.Buffer, size);
+                    } else {
+                        ssd1306_WriteString(text, *f->font, (SSD1306_COLOR)color);
+                    }
+                }
+                if (memcmp(expected, panel.Buffer, size) != 0) {
+                    printf("%s: \"%s\" em y=%u, cor %d, %u graus: pixels diferentes\n",
+                           f->name, text, y, color, ssd1306_GetRotation() * 90);
+                    failures++;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/* Microssegundos por string (texto em RAM, fora do cache de textos) */
+static double time_string(const TextFont_t* f, char* text, int reference) {
+    uint64_t start = now_us(), elapsed;
+    uint32_t runs = 0;
+
+    do {
+        for (int k = 0; k < 64; k++) {
+            ssd1306_SetCursor(0, 3);
+            if (reference) {
+                ref_WriteString(text, f->reference, White);
+            } else {
+                ssd1306_WriteString(text, *f->font, White);
+            }
+        }
+        runs += 64;
+        elapsed = now_us() - start;
+    } while (elapsed < BENCH_MIN_US);
+    return (double)elapsed / runs;
+}
+
+int main(void) {
+    SSD1306_Config_t config = {
+        .i2c = SSD1306_I2C_PORT,
+        .address = SSD1306_I2C_ADDR,
+        .width = SSD1306_WIDTH,
+        .height = SSD1306_HEIGHT,
+        .rotation = SSD1306_ROTATE_0,
+    };
+    int failures = 0;
+
+    ssd1306_InitDisplay(&panel, &config);
+    ssd1306_Select(&panel);
+
+    printf("fonte   texto              antes_us  agora_us  ganho\n");
+    for (size_t i = 0; i < sizeof(Fonts) / sizeof(Fonts[0]); i++) {
+        const TextFont_t *f = &Fonts[i];
+        char text[] = "192.168.100.200";
+        // Fontes largas: só o que cabe na largura do painel
+        if (panel.Width / f->font->width < strlen(text)) {
+            text[panel.Width / f->font->width] = '\0';
+        }
+
+        failures += check_font(f);
+        double before = time_string(f, text, 1);
+        double after = time_string(f, text, 0);
+        printf("%-7s %-18s %8.2f  %8.2f  %5.1fx\n", f->name, text, before, after, before / after);
+    }
+
+    int portrait = 0;
+    make_tall_font();
+    ssd1306_SetRotation(SSD1306_ROTATE_90);
+    for (size_t i = 0; i < sizeof(Fonts) / sizeof(Fonts[0]); i++) {
+        portrait += check_font(&Fonts[i]);
+    }
+    for (size_t i = 0; i < sizeof(TallFonts) / sizeof(TallFonts[0]); i++) {
+        portrait += check_font(&TallFonts[i]);
+    }
+    printf("retrato (90 graus), %u fontes: %d falhas\n",
+           (unsigned)(sizeof(Fonts) / sizeof(Fonts[0]) + sizeof(TallFonts) / sizeof(TallFonts[0])), portrait);
+    failures += portrait;
+    return failures ? 1 : 0;
+}